@@ -0,0 +1,720 @@
+#ifndef AVL_TREE_H
+#define AVL_TREE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <optional>
+#include <chrono>
+#include <iomanip>
+#include <sys/resource.h>
+
+#include "Post.h"
+#include "PostIndex.h"
+#include "PostRange.h"
+#include "PostLoader.h"
+#include "NodeArena.h"
+
+using namespace std;
+
+// Height-balanced third engine: same post API as BinarySearchTree and Treap,
+// but every insert and delete rebalances with rotations so the height stays
+// below 1.44 log2(n) on any input order - sorted dataset loads included.
+class AVLTree {
+private:
+    struct AVLNode {
+        string postId;       // Unique identifier for the post
+        long long timestamp; // Key for tree ordering (with postId)
+        int score;           // Popularity score
+        int height;          // Levels in this subtree (leaf = 1)
+        int size;            // Nodes in this subtree (order statistics)
+        AVLNode* left;
+        AVLNode* right;
+        AVLNode* parent;     // Upward rebalancing and range iterators without a stack
+        AVLNode* top;        // Highest-score node in this subtree (augmentation)
+
+        AVLNode(string id, long long ts, int sc)
+        : postId(std::move(id)), timestamp(ts), score(sc), height(1), size(1),
+          left(nullptr), right(nullptr), parent(nullptr), top(this) {}
+    };
+
+    AVLNode* root;
+    long long nodeCount;
+    long long rotationCount;
+    const long long MAX_NODES = 150000000LL; // 150 million safety limit
+    PostIndex<AVLNode> index;               // postId -> node, O(1) expected lookup
+    NodeArena<AVLNode> arena;               // Slab storage for every node of this tree
+
+    static int heightOf(AVLNode* node) {
+        return node ? node->height : 0;
+    }
+
+    static int sizeOf(AVLNode* node) {
+        return node ? node->size : 0;
+    }
+
+    // Recompute height, size and top from the node and its children
+    static void update(AVLNode* node) {
+        node->height = 1 + max(heightOf(node->left), heightOf(node->right));
+        node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+        node->top = node;
+        if (node->left && node->left->top->score > node->top->score) node->top = node->left->top;
+        if (node->right && node->right->top->score > node->top->score) node->top = node->right->top;
+    }
+
+    // The link (root or the parent's child pointer) that holds node
+    AVLNode*& linkOf(AVLNode* node) {
+        if (!node->parent) return root;
+        return node->parent->left == node ? node->parent->left : node->parent->right;
+    }
+
+    // Lift node->right above node; returns the new subtree root
+    AVLNode* rotateLeft(AVLNode* node) {
+        AVLNode* pivot = node->right;
+        linkOf(node) = pivot;
+        pivot->parent = node->parent;
+
+        node->right = pivot->left;
+        if (pivot->left) pivot->left->parent = node;
+        pivot->left = node;
+        node->parent = pivot;
+
+        update(node);
+        update(pivot);
+        rotationCount++;
+        return pivot;
+    }
+
+    // Lift node->left above node; returns the new subtree root
+    AVLNode* rotateRight(AVLNode* node) {
+        AVLNode* pivot = node->left;
+        linkOf(node) = pivot;
+        pivot->parent = node->parent;
+
+        node->left = pivot->right;
+        if (pivot->right) pivot->right->parent = node;
+        pivot->right = node;
+        node->parent = pivot;
+
+        update(node);
+        update(pivot);
+        rotationCount++;
+        return pivot;
+    }
+
+    // Restore |balance| <= 1 at node with a single or double rotation;
+    // returns whichever node now roots this subtree
+    AVLNode* rebalance(AVLNode* node) {
+        int balance = heightOf(node->left) - heightOf(node->right);
+        if (balance > 1) {
+            if (heightOf(node->left->left) < heightOf(node->left->right)) rotateLeft(node->left);
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (heightOf(node->right->right) < heightOf(node->right->left)) rotateRight(node->right);
+            return rotateLeft(node);
+        }
+        update(node);
+        return node;
+    }
+
+    // Walk from node to the root fixing heights, sizes, tops and balance -
+    // O(log n). The whole path is visited because size and top change on
+    // every ancestor even where the height does not.
+    void rebalanceUpward(AVLNode* node) {
+        while (node) {
+            node = rebalance(node)->parent;
+        }
+    }
+
+    // Get current memory usage in MB
+    long long getMemoryUsageMB() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024; // Convert KB to MB
+    }
+
+    // ITERATIVE insert: plain descent, then rebalance on the way back up
+    void insertIterative(const string& postId, long long timestamp, int score) {
+        if (nodeCount >= MAX_NODES) {
+            std::cerr << "ERROR: Node limit reached (" << MAX_NODES << " nodes)" << std::endl;
+            return;
+        }
+
+        // Post IDs are unique - re-adding an existing ID is ignored
+        if (index.find(postId)) return;
+
+        AVLNode* newNode = arena.create(postId, timestamp, score);
+        index.insert(newNode);
+        nodeCount++;
+
+        if (!root) {
+            root = newNode;
+            return;
+        }
+
+        AVLNode* current = root;
+        while (true) {
+            // Composite key (timestamp, postId) - unique, so never equal
+            AVLNode*& child = postKeyLess(timestamp, postId, current->timestamp, current->postId)
+                            ? current->left : current->right;
+            if (!child) {
+                child = newNode;
+                newNode->parent = current;
+                break;
+            }
+            current = child;
+        }
+        rebalanceUpward(current);
+    }
+
+    // Find a post by its composite key with one descent - O(log n)
+    AVLNode* findByKeyIterative(long long timestamp, const string& postId) {
+        AVLNode* node = root;
+        while (node && (node->timestamp != timestamp || node->postId != postId)) {
+            node = postKeyLess(timestamp, postId, node->timestamp, node->postId) ? node->left : node->right;
+        }
+        return node;
+    }
+
+    // Unlink targetNode, free it and rebalance from the lowest changed node - O(log n)
+    void deleteNodeIterative(AVLNode* targetNode) {
+        AVLNode* changedFrom; // Lowest node whose subtree lost targetNode
+        if (targetNode->left && targetNode->right) {
+            // Two children: splice in the in-order successor (leftmost of right subtree)
+            AVLNode* successor = PostRange<AVLNode>::leftmost(targetNode->right);
+            changedFrom = (successor->parent == targetNode) ? successor : successor->parent;
+            linkOf(successor) = successor->right;
+            if (successor->right) successor->right->parent = successor->parent;
+
+            successor->left = targetNode->left;
+            successor->right = targetNode->right;
+            successor->left->parent = successor;
+            if (successor->right) successor->right->parent = successor;
+
+            successor->parent = targetNode->parent;
+            linkOf(targetNode) = successor;
+        } else {
+            // Zero or one child: lift the child into the target's place
+            AVLNode* child = targetNode->left ? targetNode->left : targetNode->right;
+            if (child) child->parent = targetNode->parent;
+            linkOf(targetNode) = child;
+            changedFrom = targetNode->parent;
+        }
+        rebalanceUpward(changedFrom);
+
+        index.erase(targetNode->postId);
+        arena.destroy(targetNode); // Slot goes on the free list for the next insert
+        nodeCount--;
+    }
+
+    // Number of posts with timestamp < ts (or <= ts when inclusive) - O(log n)
+    long long countBeforeIterative(long long ts, bool inclusive) {
+        long long count = 0;
+        AVLNode* node = root;
+        while (node) {
+            if (node->timestamp < ts || (inclusive && node->timestamp == ts)) {
+                count += sizeOf(node->left) + 1;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+        return count;
+    }
+
+    // k-th most recent node (1-based) using subtree sizes - O(log n)
+    AVLNode* selectByRecencyIterative(long long k) {
+        if (k < 1 || k > sizeOf(root)) return nullptr;
+
+        AVLNode* node = root;
+        while (node) {
+            long long newer = sizeOf(node->right);
+            if (k <= newer) {
+                node = node->right;
+            } else if (k == newer + 1) {
+                return node;
+            } else {
+                k -= newer + 1;
+                node = node->left;
+            }
+        }
+        return nullptr;
+    }
+
+    // Recency rank of node (1 = most recent) - O(log n)
+    long long rankOfIterative(AVLNode* node) {
+        long long rank = sizeOf(node->right) + 1;
+        for (; node->parent; node = node->parent) {
+            if (node->parent->left == node) {
+                rank += sizeOf(node->parent->right) + 1;
+            }
+        }
+        return rank;
+    }
+
+    // Build a perfectly balanced tree from key-sorted nodes - O(n).
+    // Sibling subtrees differ in size by at most one, so the result is a
+    // valid AVL tree and heights only need filling in bottom-up.
+    void buildBalancedIterative(vector<AVLNode*>& nodes) {
+        struct Range {
+            long long lo, hi;   // Inclusive bounds into nodes
+            AVLNode* parent;
+            AVLNode** link;
+        };
+
+        vector<Range> pending;
+        vector<AVLNode*> preorder; // Parents before children
+        preorder.reserve(nodes.size());
+        if (!nodes.empty()) pending.push_back({0, (long long)nodes.size() - 1, nullptr, &root});
+
+        while (!pending.empty()) {
+            Range r = pending.back();
+            pending.pop_back();
+
+            long long mid = r.lo + (r.hi - r.lo) / 2;
+
+            AVLNode* node = nodes[mid];
+            node->parent = r.parent;
+            *r.link = node;
+            preorder.push_back(node);
+
+            if (mid > r.lo) pending.push_back({r.lo, mid - 1, node, &node->left});
+            if (mid < r.hi) pending.push_back({mid + 1, r.hi, node, &node->right});
+        }
+
+        // Children before parents
+        for (size_t i = preorder.size(); i > 0; i--) {
+            update(preorder[i - 1]);
+        }
+    }
+
+    // Highest-score node with from <= timestamp <= to - O(log n), by the
+    // same split-point boundary walk as BinarySearchTree
+    AVLNode* mostPopularInRangeIterative(long long from, long long to) {
+        AVLNode* node = root;
+        while (node && (node->timestamp < from || node->timestamp > to)) {
+            node = (node->timestamp < from) ? node->right : node->left;
+        }
+        if (!node) return nullptr;
+
+        AVLNode* best = node;
+        auto consider = [&best](AVLNode* candidate) {
+            if (candidate->score > best->score) best = candidate;
+        };
+
+        for (AVLNode* current = node->left; current; ) {
+            if (current->timestamp >= from) {
+                consider(current);
+                if (current->right) consider(current->right->top);
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+        for (AVLNode* current = node->right; current; ) {
+            if (current->timestamp <= to) {
+                consider(current);
+                if (current->left) consider(current->left->top);
+                current = current->right;
+            } else {
+                current = current->left;
+            }
+        }
+        return best;
+    }
+
+    // Depth of the shallowest missing child (BFS)
+    int calculateMinHeightIterative() {
+        if (!root) return 0;
+
+        queue<pair<AVLNode*, int>> q;
+        q.push({root, 1});
+        while (true) {
+            auto [node, depth] = q.front();
+            q.pop();
+            if (!node->left || !node->right) return depth;
+            q.push({node->left, depth + 1});
+            q.push({node->right, depth + 1});
+        }
+    }
+
+    // Result view of a node for the typed queries
+    static PostView viewOf(const AVLNode* node) {
+        return PostView{node->postId, node->timestamp, node->score};
+    }
+
+    // Newest k posts by stepping to the in-order predecessor - O(log n + k)
+    size_t reverseInorderIterative(int k, PostView* out) {
+        size_t count = 0;
+        for (AVLNode* node = PostRange<AVLNode>::rightmost(root);
+             node && count < (size_t)k; node = PostRange<AVLNode>::predecessor(node)) {
+            out[count++] = viewOf(node);
+        }
+        return count;
+    }
+
+    // ITERATIVE clear: run node destructors (postId strings) with an
+    // explicit stack, then hand all slabs back to the system at once
+    void clearIterative() {
+        if (root && arena.needsDestructor()) {
+            vector<AVLNode*> st;
+            st.push_back(root);
+
+            while (!st.empty()) {
+                AVLNode* node = st.back();
+                st.pop_back();
+
+                if (node->left) st.push_back(node->left);
+                if (node->right) st.push_back(node->right);
+
+                node->~AVLNode();
+            }
+        }
+        arena.release();
+
+        root = nullptr;
+        nodeCount = 0;
+        index.clear();
+    }
+
+    void printVerticalStructure_helper(AVLNode* node, const string& prefix, bool isTail, const string& branchLabel) {
+        struct Frame {
+            AVLNode* node;
+            string prefix;
+            bool isTail;
+            const char* branchLabel;
+        };
+
+        vector<Frame> pending;
+        if (node != nullptr) pending.push_back({node, prefix, isTail, branchLabel.c_str()});
+
+        while (!pending.empty()) {
+            Frame frame = std::move(pending.back());
+            pending.pop_back();
+
+            cout << frame.prefix;
+            if (frame.isTail) {
+                // L-shaped corner: '└── '
+                cout << "└── ";
+            } else {
+                // T-shaped connector: '├── '
+                cout << "├── ";
+            }
+
+            cout << "TS: " << frame.node->timestamp << frame.branchLabel
+                << " | ID: " << frame.node->postId
+                << " | Score: " << frame.node->score
+                << " | H: " << frame.node->height << endl;
+
+            string newPrefix = frame.prefix + (frame.isTail ? "    " : "│   "); // '|   ' or '    '
+
+            // Push right first so the left child is printed first
+            if (frame.node->right != nullptr) {
+                pending.push_back({frame.node->right, newPrefix, true, " (R)"});
+            }
+            if (frame.node->left != nullptr) {
+                pending.push_back({frame.node->left, newPrefix, frame.node->right == nullptr, " (L)"});
+            }
+        }
+    }
+
+    // Print a load summary in the same shape as the other engines' loaders
+    void reportLoad(const string& title, const LoadStats& stats, int timeoutSeconds) {
+        if (!stats.opened) return;
+        if (stats.timedOut) {
+            std::cout << "\n[AVL] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
+        }
+        std::cout << "\n ---------- [AVL] " << title << " ------------" << std::endl;
+        std::cout << "[AVL] Posts: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3) << stats.seconds
+                  << "s | Memory: " << getMemoryUsageMB() << " MB | Height: " << getHeight()
+                  << " | Rotations: " << rotationCount << std::endl << std::endl;
+    }
+
+public:
+    AVLTree() : root(nullptr), nodeCount(0), rotationCount(0) {}
+
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+
+    // calculate minimum height
+    int calculateMinHeight() {
+        return calculateMinHeightIterative();
+    }
+
+    // Print tree vertical structure (with per-node heights)
+    void printVerticalStructure() {
+        if (root == nullptr) {
+            cout << "The AVL tree is empty." << endl;
+            return;
+        }
+        cout << "--- AVL Structure (Vertical View) ---" << endl;
+        cout << "ROOT: TS: " << root->timestamp << " | ID: " << root->postId
+            << " | Score: " << root->score << " | H: " << root->height << endl;
+
+        if (root->left != nullptr) {
+            printVerticalStructure_helper(root->left, "", root->right == nullptr, " (L)");
+        }
+        if (root->right != nullptr) {
+            printVerticalStructure_helper(root->right, "", true, " (R)");
+        }
+        cout << "-------------------------------------" << endl;
+    }
+
+    // add Post - O(log n) worst case
+    void addPost(const string& postId, long long timestamp, int score) {
+        insertIterative(postId, timestamp, score);
+    }
+
+    // Delete Post - O(log n) worst case
+    void deletePost(const string& postId) {
+        AVLNode* node = index.find(postId);
+        if (node) deleteNodeIterative(node);
+    }
+
+    // Like Post
+    void likePost(const string& postId) {
+        updateScore(postId, 1);
+    }
+
+    // Adjust a post's score by delta and refresh the max-score augmentation
+    // along its ancestors - O(log n). Returns false if not found.
+    bool updateScore(const string& postId, int delta) {
+        AVLNode* node = index.find(postId);
+        if (!node) return false;
+
+        node->score += delta;
+        for (; node; node = node->parent) {
+            update(node);
+        }
+        return true;
+    }
+
+    // Print post by ID
+    void printPostById(const string& postId) {
+        AVLNode* node = index.find(postId);
+        cout << "[AVL] ";
+        if (node) {
+            cout << "Post Found: [" << node->postId << ": T=" << node->timestamp
+                 << ", S=" << node->score << "]" << endl;
+        } else {
+            cout << "Post ID " << postId << " not found in AVL tree." << endl;
+        }
+    }
+
+    // Get the most popular post (highest score) - O(1) via root->top
+    optional<PostView> getMostPopular() {
+        AVLNode* maxNode = root ? root->top : nullptr;
+        if (maxNode) {
+            return viewOf(maxNode);
+        }
+        return nullopt;
+    }
+
+    // Most popular post with from <= timestamp <= to - O(log n)
+    optional<PostView> getMostPopularInRange(long long from, long long to) {
+        AVLNode* maxNode = mostPopularInRangeIterative(from, to);
+        if (maxNode) {
+            return viewOf(maxNode);
+        }
+        return nullopt;
+    }
+
+    // k most recent posts, newest first, written to out (room for k) -
+    // returns how many were written
+    size_t getMostRecent(int k, PostView* out) {
+        return k > 0 ? reverseInorderIterative(k, out) : 0;
+    }
+
+    // Replace the tree with a perfectly balanced one built from posts in O(n)
+    // (plus an O(n log n) sort if they are not already in (timestamp, postId) order)
+    void buildFromSorted(vector<Post>&& posts) {
+        clearIterative();
+
+        auto byKey = [](const Post& a, const Post& b) { return postKeyLess(a, b); };
+        if (!is_sorted(posts.begin(), posts.end(), byKey)) {
+            stable_sort(posts.begin(), posts.end(), byKey);
+        }
+
+        vector<AVLNode*> nodes;
+        nodes.reserve(posts.size());
+        index.reserve(posts.size());
+        for (Post& post : posts) {
+            if ((long long)nodes.size() >= MAX_NODES) {
+                std::cerr << "ERROR: Node limit reached (" << MAX_NODES << " nodes)" << std::endl;
+                break;
+            }
+            AVLNode* node = arena.create(std::move(post.postId), post.timestamp, post.score);
+            if (!index.insert(node)) {
+                arena.destroy(node); // Post IDs are unique - duplicates are ignored
+                continue;
+            }
+            nodes.push_back(node);
+        }
+        posts.clear();
+
+        buildBalancedIterative(nodes);
+        nodeCount = nodes.size();
+    }
+
+    // Post with exactly this (timestamp, postId), or nullptr - O(log n)
+    const AVLNode* find(long long timestamp, const string& postId) {
+        return findByKeyIterative(timestamp, postId);
+    }
+
+    // Delete the post with this (timestamp, postId) - O(log n).
+    // Returns false if there is no such post.
+    bool erase(long long timestamp, const string& postId) {
+        AVLNode* node = findByKeyIterative(timestamp, postId);
+        if (!node) return false;
+        deleteNodeIterative(node);
+        return true;
+    }
+
+    // Number of posts with t1 <= timestamp <= t2 - O(log n)
+    long long countInRange(long long t1, long long t2) {
+        if (t1 > t2) return 0;
+        return countBeforeIterative(t2, true) - countBeforeIterative(t1, false);
+    }
+
+    // k-th most recent post (k = 1 is the newest) - O(log n)
+    optional<PostView> selectByRecency(long long k) {
+        AVLNode* node = selectByRecencyIterative(k);
+        if (node) {
+            return viewOf(node);
+        }
+        return nullopt;
+    }
+
+    // Recency rank of a post (1 = most recent), 0 if not found - O(log n)
+    long long rankOf(const string& postId) {
+        AVLNode* node = index.find(postId);
+        return node ? rankOfIterative(node) : 0;
+    }
+
+    // Posts with from <= timestamp <= to, iterable oldest-first (begin/end)
+    // or newest-first (reversed()) without copying - O(log n + k)
+    PostRange<AVLNode> rangeQuery(long long from, long long to) {
+        return PostRange<AVLNode>(root, from, to);
+    }
+
+    // Top k posts by score with from <= timestamp <= to, highest first,
+    // written to out (room for k) - O(log n + m log k) for m posts in the
+    // window. Returns how many were written.
+    size_t topKByScore(long long from, long long to, int k, PostView* out) {
+        return keepTopKByScore(rangeQuery(from, to), k, out);
+    }
+
+    // Height is stored on the root - O(1)
+    int getHeight() {
+        return heightOf(root);
+    }
+
+    long long getNodeCount() const {
+        return nodeCount;
+    }
+
+    long long getRotationCount() const {
+        return rotationCount;
+    }
+
+    void resetRotationCount() {
+        rotationCount = 0;
+    }
+
+    // Process RSS plus the bytes held by this tree's node arena and index
+    MemoryUsage getMemoryUsage() {
+        return MemoryUsage{getMemoryUsageMB(), arena.reservedBytes(), arena.liveBytes(), index.memoryBytes()};
+    }
+
+    //////////////////////////////////////////////////////////
+    //////////////// Loading from Data set ///////////////////
+    //////////////////////////////////////////////////////////
+
+    // 30-second sample; returns the projected time for the full dataset, or
+    // the load time if the whole file fit in the sample.
+    // bulkBuild: parse every row first, then buildFromSorted() once at the end
+    double loadFromCSV(const std::string& filename, bool bulkBuild = false) {
+        std::cout << "[AVL] Starting CSV load from: " << filename << std::endl;
+
+        vector<Post> parsed;
+        LoadStats stats = PostLoader::readCSV(filename, "[AVL]", 30.0,
+            [&](string_view id, long long timestamp, int score) {
+                if (bulkBuild) {
+                    parsed.push_back({string(id), timestamp, score});
+                } else {
+                    insertIterative(string(id), timestamp, score);
+                }
+            });
+        if (!stats.opened) return 0.0;
+        if (bulkBuild) buildFromSorted(std::move(parsed));
+
+        reportLoad("CSV LOAD COMPLETE", stats, 30);
+        return stats.timedOut ? PostLoader::estimateFullLoad(stats) : stats.seconds;
+    }
+
+    void loadFromCSVWithTimeout(const std::string& filename, int timeoutSeconds = 30) {
+        LoadStats stats = PostLoader::readCSV(filename, "[AVL]", timeoutSeconds,
+            [this](string_view id, long long timestamp, int score) {
+                insertIterative(string(id), timestamp, score);
+            });
+        reportLoad("CSV LOAD COMPLETE", stats, timeoutSeconds);
+    }
+
+    // Whole CSV parsed on threads cores (0 = all of them) and bulk built, or
+    // as much of it as is parsed within timeLimit seconds
+    ParallelLoadStats loadFromCSVParallel(const std::string& filename, int threads = 0, double timeLimit = 30.0) {
+        std::cout << "[AVL] Starting parallel CSV load from: " << filename << std::endl;
+
+        std::vector<Post> parsed;
+        ParallelLoadStats stats = PostLoader::readCSVParallel(filename, "[AVL]", timeLimit, threads, parsed);
+        if (!stats.opened) return stats;
+
+        auto buildStart = std::chrono::high_resolution_clock::now();
+        buildFromSorted(std::move(parsed));
+        stats.buildSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - buildStart).count();
+        stats.seconds += stats.buildSeconds;
+
+        reportLoad("PARALLEL CSV LOAD COMPLETE", stats, (int)timeLimit);
+        return stats;
+    }
+
+    // 30-second sample of the zstd JSON dump; returns the projected time for
+    // the full dataset, or the load time if the whole dump fit in the sample.
+    double loadFromTGZ(const std::string& tgzFilename, bool bulkBuild = false) {
+        std::cout << "[AVL] Loading from compressed dataset: " << tgzFilename << std::endl;
+
+        vector<Post> parsed;
+        LoadStats stats = PostLoader::readZST(tgzFilename, "[AVL]", 30.0, !bulkBuild,
+            [&](string_view id, long long timestamp, int score) {
+                if (bulkBuild) {
+                    parsed.push_back({string(id), timestamp, score});
+                } else {
+                    insertIterative(string(id), timestamp, score);
+                }
+            });
+        if (!stats.opened) return 0.0;
+        if (bulkBuild) buildFromSorted(std::move(parsed));
+
+        reportLoad("LOAD COMPLETE", stats, 30);
+        return stats.timedOut ? PostLoader::estimateFullLoad(stats) : stats.seconds;
+    }
+
+    void loadFromTGZWithTimeout(const std::string& tgzFilename, int timeoutSeconds = 30) {
+        std::cout << "[AVL] Starting streaming load..." << std::endl;
+        LoadStats stats = PostLoader::readZST(tgzFilename, "[AVL]", timeoutSeconds,
+            [this](string_view id, long long timestamp, int score) {
+                insertIterative(string(id), timestamp, score);
+            });
+        reportLoad("LOAD COMPLETE", stats, timeoutSeconds);
+    }
+
+    // Destructor
+    ~AVLTree() {
+        clearIterative();
+    }
+};
+
+#endif // AVL_TREE_H
@@ -0,0 +1,742 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <optional>
+#include <chrono>
+#include <iomanip>
+#include <sys/resource.h>
+
+#include "Post.h"
+#include "PostIndex.h"
+#include "PostLoader.h"
+#include "ScoreHeap.h"
+#include "NodeArena.h"
+
+using namespace std;
+
+// Cache-friendly engine: a B+ tree with fat, cache-line-aligned nodes.
+// A node holds up to 31 keys in one dense timestamp array, so a lookup
+// costs one short in-node search per level (height 4-5 for 100M posts)
+// instead of one cache miss per binary level. Posts live only in the
+// leaves, which are doubly linked, so getMostRecent and time ranges are
+// sequential scans.
+//
+// Posts are ordered by (timestamp, postId) like the other trees. Inner
+// separators hold timestamps only; equal timestamps may straddle two
+// leaves, which the leaf-level walk in findLeaf() resolves.
+//
+// Deletion is free-at-empty: a leaf is unlinked only once it has no posts
+// left (and an inner node once it has no children), without borrowing or
+// merging. All leaves stay at the same depth, and with insert-heavy
+// workloads nodes stay well filled.
+class BPlusTree {
+private:
+    struct Leaf;
+
+    struct PostRecord {
+        string postId;       // Unique identifier for the post
+        long long timestamp; // Key for tree ordering (with postId)
+        int score;           // Popularity score
+        size_t heapPos;      // Slot in the popularity heap
+        Leaf* leaf;          // Leaf currently holding this post
+
+        PostRecord(string id, long long ts, int sc)
+        : postId(std::move(id)), timestamp(ts), score(sc), heapPos(0), leaf(nullptr) {}
+    };
+
+    // Keys per node; arrays hold one spare slot so a node can overflow by
+    // one entry and then split
+    static constexpr int LEAF_CAPACITY = 31;
+    static constexpr int INNER_CAPACITY = 31;
+
+    struct Inner;
+
+    // Header shared by both node kinds
+    struct NodeBase {
+        Inner* parent;
+        int count;   // Leaf: posts held. Inner: separators (children = count + 1)
+        bool isLeaf;
+    };
+
+    struct alignas(64) Leaf : NodeBase {
+        long long keys[LEAF_CAPACITY + 1];         // Post timestamps, dense for in-node search
+        PostRecord* records[LEAF_CAPACITY + 1];
+        Leaf* prev;
+        Leaf* next;
+
+        Leaf() : NodeBase{nullptr, 0, true}, prev(nullptr), next(nullptr) {}
+    };
+
+    struct alignas(64) Inner : NodeBase {
+        long long keys[INNER_CAPACITY + 1];        // keys[i] separates children[i] and children[i + 1]
+        NodeBase* children[INNER_CAPACITY + 2];
+
+        Inner() : NodeBase{nullptr, 0, false} {}
+    };
+
+    NodeBase* root;
+    Leaf* head;           // Oldest leaf
+    Leaf* tail;           // Newest leaf
+    int height;           // Levels, leaves included (0 = empty)
+    long long nodeCount;  // Posts stored
+    long long splitCount; // Leaf and inner node splits
+    const long long MAX_NODES = 150000000LL; // 150 million safety limit
+
+    PostIndex<PostRecord> index;        // postId -> record, O(1) expected lookup
+    ScoreHeap<PostRecord> popularity;   // Serves getMostPopular in O(1)
+    NodeArena<PostRecord> recordArena;
+    NodeArena<Leaf> leafArena;
+    NodeArena<Inner> innerArena;
+
+    // Get current memory usage in MB
+    long long getMemoryUsageMB() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024; // Convert KB to MB
+    }
+
+    // Leftmost leaf that can hold posts with this timestamp - O(height)
+    Leaf* descend(long long timestamp) const {
+        NodeBase* node = root;
+        while (!node->isLeaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            int i = lower_bound(inner->keys, inner->keys + inner->count, timestamp) - inner->keys;
+            node = inner->children[i];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    // Leaf where (timestamp, postId) is or belongs: descend by timestamp,
+    // then step right past leaves whose posts all sort before the key
+    Leaf* findLeaf(long long timestamp, const string& postId) const {
+        Leaf* leaf = descend(timestamp);
+        while (leaf->next && !postKeyLess(timestamp, postId, leaf->next->keys[0], leaf->next->records[0]->postId)) {
+            leaf = leaf->next;
+        }
+        return leaf;
+    }
+
+    // First slot in leaf whose key is not less than (timestamp, postId)
+    static int slotOf(const Leaf* leaf, long long timestamp, const string& postId) {
+        int i = lower_bound(leaf->keys, leaf->keys + leaf->count, timestamp) - leaf->keys;
+        while (i < leaf->count && leaf->keys[i] == timestamp && leaf->records[i]->postId < postId) i++;
+        return i;
+    }
+
+    static int childIndex(const Inner* parent, const NodeBase* child) {
+        int j = 0;
+        while (parent->children[j] != child) j++;
+        return j;
+    }
+
+    void insertRecord(PostRecord* record) {
+        if (!root) {
+            Leaf* leaf = leafArena.create();
+            root = head = tail = leaf;
+            height = 1;
+        }
+
+        Leaf* leaf = findLeaf(record->timestamp, record->postId);
+        int pos = slotOf(leaf, record->timestamp, record->postId);
+        for (int i = leaf->count; i > pos; i--) {
+            leaf->keys[i] = leaf->keys[i - 1];
+            leaf->records[i] = leaf->records[i - 1];
+        }
+        leaf->keys[pos] = record->timestamp;
+        leaf->records[pos] = record;
+        leaf->count++;
+        record->leaf = leaf;
+
+        if (leaf->count > LEAF_CAPACITY) splitLeaf(leaf, pos);
+    }
+
+    // Move the upper part of an overflowing leaf into a new right sibling.
+    // An append to the newest leaf (time-ordered loading) moves only the new
+    // post, so sequential loads leave full leaves behind instead of half-full ones.
+    void splitLeaf(Leaf* leaf, int insertedAt) {
+        Leaf* right = leafArena.create();
+        int keep = (leaf == tail && insertedAt == leaf->count - 1) ? LEAF_CAPACITY : (LEAF_CAPACITY + 1) / 2;
+
+        right->count = leaf->count - keep;
+        for (int i = 0; i < right->count; i++) {
+            right->keys[i] = leaf->keys[keep + i];
+            right->records[i] = leaf->records[keep + i];
+            right->records[i]->leaf = right;
+        }
+        leaf->count = keep;
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next) leaf->next->prev = right; else tail = right;
+        leaf->next = right;
+
+        splitCount++;
+        insertSeparator(leaf, right->keys[0], right);
+    }
+
+    // Hang right next to left under left's parent with separator key,
+    // splitting full inner nodes upward - O(height) iteratively
+    void insertSeparator(NodeBase* left, long long key, NodeBase* right) {
+        // Growth at the newest edge of the tree splits inner nodes unevenly too
+        bool appending = (right == tail);
+        while (true) {
+            Inner* parent = left->parent;
+            if (!parent) {
+                Inner* newRoot = innerArena.create();
+                newRoot->count = 1;
+                newRoot->keys[0] = key;
+                newRoot->children[0] = left;
+                newRoot->children[1] = right;
+                left->parent = right->parent = newRoot;
+                root = newRoot;
+                height++;
+                return;
+            }
+
+            int j = childIndex(parent, left);
+            for (int i = parent->count; i > j; i--) {
+                parent->keys[i] = parent->keys[i - 1];
+                parent->children[i + 1] = parent->children[i];
+            }
+            parent->keys[j] = key;
+            parent->children[j + 1] = right;
+            right->parent = parent;
+            parent->count++;
+
+            if (parent->count <= INNER_CAPACITY) return;
+
+            // Split: the middle separator moves up, the upper half moves right
+            appending = appending && j + 1 == parent->count;
+            Inner* sibling = innerArena.create();
+            int mid = appending ? parent->count - 1 : parent->count / 2;
+            sibling->count = parent->count - mid - 1;
+            for (int i = 0; i < sibling->count; i++) {
+                sibling->keys[i] = parent->keys[mid + 1 + i];
+            }
+            for (int i = 0; i <= sibling->count; i++) {
+                sibling->children[i] = parent->children[mid + 1 + i];
+                sibling->children[i]->parent = sibling;
+            }
+            parent->count = mid;
+            splitCount++;
+
+            left = parent;
+            key = parent->keys[mid];
+            right = sibling;
+        }
+    }
+
+    // Take record out of its leaf; empty leaves and inner nodes are unlinked
+    void removeRecord(PostRecord* record) {
+        Leaf* leaf = record->leaf;
+        int pos = 0;
+        while (leaf->records[pos] != record) pos++;
+        for (int i = pos; i + 1 < leaf->count; i++) {
+            leaf->keys[i] = leaf->keys[i + 1];
+            leaf->records[i] = leaf->records[i + 1];
+        }
+        leaf->count--;
+
+        if (leaf->count == 0) removeLeaf(leaf);
+    }
+
+    void removeLeaf(Leaf* leaf) {
+        if (leaf->prev) leaf->prev->next = leaf->next; else head = leaf->next;
+        if (leaf->next) leaf->next->prev = leaf->prev; else tail = leaf->prev;
+
+        NodeBase* child = leaf;
+        Inner* parent = leaf->parent;
+        leafArena.destroy(leaf);
+
+        // Walk up while removing the child leaves its parent empty
+        while (parent && parent->count == 0) {
+            child = parent;
+            parent = parent->parent;
+            innerArena.destroy(static_cast<Inner*>(child));
+        }
+
+        if (!parent) {
+            // The whole tree emptied out
+            root = nullptr;
+            head = tail = nullptr;
+            height = 0;
+            return;
+        }
+
+        // Drop the child and one adjacent separator; the remaining
+        // separators still bound their neighbours
+        int j = childIndex(parent, child);
+        for (int i = (j == 0 ? 0 : j - 1); i + 1 < parent->count; i++) {
+            parent->keys[i] = parent->keys[i + 1];
+        }
+        for (int i = j; i < parent->count; i++) {
+            parent->children[i] = parent->children[i + 1];
+        }
+        parent->count--;
+
+        // A root with a single child is one useless level
+        while (!root->isLeaf && root->count == 0) {
+            Inner* oldRoot = static_cast<Inner*>(root);
+            root = oldRoot->children[0];
+            root->parent = nullptr;
+            innerArena.destroy(oldRoot);
+            height--;
+        }
+    }
+
+    void deleteRecord(PostRecord* record) {
+        removeRecord(record);
+        popularity.remove(record);
+        index.erase(record->postId);
+        recordArena.destroy(record);
+        nodeCount--;
+    }
+
+    void insertIterative(const string& postId, long long timestamp, int score) {
+        if (nodeCount >= MAX_NODES) {
+            std::cerr << "ERROR: Node limit reached (" << MAX_NODES << " nodes)" << std::endl;
+            return;
+        }
+
+        // Post IDs are unique - re-adding an existing ID is ignored
+        if (index.find(postId)) return;
+
+        PostRecord* record = recordArena.create(postId, timestamp, score);
+        index.insert(record);
+        popularity.push(record);
+        insertRecord(record);
+        nodeCount++;
+    }
+
+    // Build the whole tree bottom-up from key-sorted records - O(n).
+    // Leaves are packed full; each inner level takes up to
+    // INNER_CAPACITY + 1 children of the level below.
+    void buildBottomUp(const vector<PostRecord*>& records) {
+        if (records.empty()) return;
+
+        vector<NodeBase*> level;
+        vector<long long> firstKeys; // Smallest timestamp below each node of level
+        Leaf* previous = nullptr;
+        for (size_t start = 0; start < records.size(); start += LEAF_CAPACITY) {
+            Leaf* leaf = leafArena.create();
+            leaf->count = (int)min<size_t>(LEAF_CAPACITY, records.size() - start);
+            for (int i = 0; i < leaf->count; i++) {
+                leaf->records[i] = records[start + i];
+                leaf->keys[i] = leaf->records[i]->timestamp;
+                leaf->records[i]->leaf = leaf;
+            }
+            leaf->prev = previous;
+            if (previous) previous->next = leaf; else head = leaf;
+            previous = leaf;
+
+            level.push_back(leaf);
+            firstKeys.push_back(leaf->keys[0]);
+        }
+        tail = previous;
+        height = 1;
+
+        while (level.size() > 1) {
+            vector<NodeBase*> upper;
+            vector<long long> upperKeys;
+            for (size_t start = 0; start < level.size(); start += INNER_CAPACITY + 1) {
+                Inner* inner = innerArena.create();
+                int children = (int)min<size_t>(INNER_CAPACITY + 1, level.size() - start);
+                inner->count = children - 1;
+                for (int i = 0; i < children; i++) {
+                    inner->children[i] = level[start + i];
+                    inner->children[i]->parent = inner;
+                    if (i > 0) inner->keys[i - 1] = firstKeys[start + i];
+                }
+                upper.push_back(inner);
+                upperKeys.push_back(firstKeys[start]);
+            }
+            level.swap(upper);
+            firstKeys.swap(upperKeys);
+            height++;
+        }
+        root = level.front();
+    }
+
+    // Result view of a record for the typed queries
+    static PostView viewOf(const PostRecord* record) {
+        return PostView{record->postId, record->timestamp, record->score};
+    }
+
+    // Run record destructors, then hand every slab back at once
+    void clearAll() {
+        for (Leaf* leaf = head; leaf; leaf = leaf->next) {
+            for (int i = 0; i < leaf->count; i++) {
+                leaf->records[i]->~PostRecord();
+            }
+        }
+        recordArena.release();
+        leafArena.release();
+        innerArena.release();
+
+        root = nullptr;
+        head = tail = nullptr;
+        height = 0;
+        nodeCount = 0;
+        index.clear();
+        popularity.clear();
+    }
+
+    // Print a load summary in the same shape as the other engines' loaders
+    void reportLoad(const string& title, const LoadStats& stats, int timeoutSeconds) {
+        if (!stats.opened) return;
+        if (stats.timedOut) {
+            std::cout << "\n[B+TREE] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
+        }
+        std::cout << "\n ---------- [B+TREE] " << title << " ------------" << std::endl;
+        std::cout << "[B+TREE] Posts: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3) << stats.seconds
+                  << "s | Memory: " << getMemoryUsageMB() << " MB | Height: " << getHeight()
+                  << " | Splits: " << splitCount << std::endl << std::endl;
+    }
+
+public:
+    // Posts with from <= timestamp <= to, oldest first, read straight out
+    // of the linked leaves. Invalidated by any insert/delete on the tree.
+    class LeafRange {
+    public:
+        class Iterator {
+        private:
+            const Leaf* leaf;
+            int slot;
+            long long to;
+
+            // Skip past exhausted leaves; stop once past the window
+            void settle() {
+                while (leaf && slot >= leaf->count) {
+                    leaf = leaf->next;
+                    slot = 0;
+                }
+                if (leaf && leaf->keys[slot] > to) {
+                    leaf = nullptr;
+                    slot = 0;
+                }
+            }
+
+        public:
+            Iterator(const Leaf* l, int s, long long t) : leaf(l), slot(s), to(t) { settle(); }
+
+            const PostRecord& operator*() const { return *leaf->records[slot]; }
+            const PostRecord* operator->() const { return leaf->records[slot]; }
+
+            Iterator& operator++() {
+                slot++;
+                settle();
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const { return leaf == other.leaf && slot == other.slot; }
+            bool operator!=(const Iterator& other) const { return !(*this == other); }
+        };
+
+    private:
+        const Leaf* first;
+        int firstSlot;
+        long long to;
+
+    public:
+        LeafRange(const Leaf* leaf, int slot, long long t) : first(leaf), firstSlot(slot), to(t) {}
+
+        Iterator begin() const { return Iterator(first, firstSlot, to); }
+        Iterator end() const { return Iterator(nullptr, 0, to); }
+    };
+
+    BPlusTree() : root(nullptr), head(nullptr), tail(nullptr), height(0), nodeCount(0), splitCount(0) {}
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    // Every leaf sits at the same depth
+    int calculateMinHeight() {
+        return height;
+    }
+
+    // add Post - O(log n)
+    void addPost(const string& postId, long long timestamp, int score) {
+        insertIterative(postId, timestamp, score);
+    }
+
+    // Delete Post - O(log n)
+    void deletePost(const string& postId) {
+        PostRecord* record = index.find(postId);
+        if (record) deleteRecord(record);
+    }
+
+    // Like Post
+    void likePost(const string& postId) {
+        updateScore(postId, 1);
+    }
+
+    // Adjust a post's score by delta; the tree is keyed by time, so only the
+    // popularity heap moves - O(log n). Returns false if not found.
+    bool updateScore(const string& postId, int delta) {
+        PostRecord* record = index.find(postId);
+        if (!record) return false;
+
+        record->score += delta;
+        popularity.update(record);
+        return true;
+    }
+
+    // Print post by ID
+    void printPostById(const string& postId) {
+        PostRecord* record = index.find(postId);
+        cout << "[B+TREE] ";
+        if (record) {
+            cout << "Post Found: [" << record->postId << ": T=" << record->timestamp
+                 << ", S=" << record->score << "]" << endl;
+        } else {
+            cout << "Post ID " << postId << " not found in B+ tree." << endl;
+        }
+    }
+
+    // Get the most popular post (highest score) - O(1) via the popularity heap
+    optional<PostView> getMostPopular() {
+        PostRecord* maxRecord = popularity.top();
+        if (maxRecord) {
+            return viewOf(maxRecord);
+        }
+        return nullopt;
+    }
+
+    // Newest k posts written to out (room for k), scanning the leaf chain
+    // backwards from the tail - O(k). Returns how many were written.
+    size_t getMostRecent(int k, PostView* out) {
+        size_t count = 0, limit = (size_t)max(k, 0);
+        for (Leaf* leaf = tail; leaf && count < limit; leaf = leaf->prev) {
+            for (int i = leaf->count - 1; i >= 0 && count < limit; i--) {
+                out[count++] = viewOf(leaf->records[i]);
+            }
+        }
+        return count;
+    }
+
+    // Posts with from <= timestamp <= to, oldest first - O(log n + k)
+    LeafRange rangeQuery(long long from, long long to) {
+        if (!root || from > to) return LeafRange(nullptr, 0, to);
+
+        Leaf* leaf = descend(from);
+        int slot = lower_bound(leaf->keys, leaf->keys + leaf->count, from) - leaf->keys;
+        return LeafRange(leaf, slot, to);
+    }
+
+    // Number of posts with t1 <= timestamp <= t2 - O(log n + k), a leaf scan
+    long long countInRange(long long t1, long long t2) {
+        long long count = 0;
+        for (const PostRecord& record : rangeQuery(t1, t2)) {
+            (void)record;
+            count++;
+        }
+        return count;
+    }
+
+    // Top k posts by score with from <= timestamp <= to, highest first,
+    // written to out (room for k) - a sequential leaf scan keeping the k
+    // best, O(log n + m log k). Returns how many were written.
+    size_t topKByScore(long long from, long long to, int k, PostView* out) {
+        return keepTopKByScore(rangeQuery(from, to), k, out);
+    }
+
+    // Replace the tree with one built bottom-up from posts in O(n)
+    // (plus an O(n log n) sort if they are not already in (timestamp, postId) order)
+    void buildFromSorted(vector<Post>&& posts) {
+        clearAll();
+
+        auto byKey = [](const Post& a, const Post& b) { return postKeyLess(a, b); };
+        if (!is_sorted(posts.begin(), posts.end(), byKey)) {
+            stable_sort(posts.begin(), posts.end(), byKey);
+        }
+
+        vector<PostRecord*> records;
+        records.reserve(posts.size());
+        index.reserve(posts.size());
+        for (Post& post : posts) {
+            if ((long long)records.size() >= MAX_NODES) {
+                std::cerr << "ERROR: Node limit reached (" << MAX_NODES << " nodes)" << std::endl;
+                break;
+            }
+            PostRecord* record = recordArena.create(std::move(post.postId), post.timestamp, post.score);
+            if (!index.insert(record)) {
+                recordArena.destroy(record); // Post IDs are unique - duplicates are ignored
+                continue;
+            }
+            popularity.push(record);
+            records.push_back(record);
+        }
+        posts.clear();
+
+        buildBottomUp(records);
+        nodeCount = records.size();
+    }
+
+    // Post with exactly this (timestamp, postId), or nullptr - O(log n)
+    const PostRecord* find(long long timestamp, const string& postId) {
+        if (!root) return nullptr;
+        Leaf* leaf = findLeaf(timestamp, postId);
+        int slot = slotOf(leaf, timestamp, postId);
+        if (slot < leaf->count && leaf->keys[slot] == timestamp && leaf->records[slot]->postId == postId) {
+            return leaf->records[slot];
+        }
+        return nullptr;
+    }
+
+    // Delete the post with this (timestamp, postId) - O(log n).
+    // Returns false if there is no such post.
+    bool erase(long long timestamp, const string& postId) {
+        const PostRecord* record = find(timestamp, postId);
+        if (!record) return false;
+        deleteRecord(const_cast<PostRecord*>(record));
+        return true;
+    }
+
+    // Levels from the root to the leaves
+    int getHeight() {
+        return height;
+    }
+
+    long long getNodeCount() const {
+        return nodeCount;
+    }
+
+    long long getSplitCount() const {
+        return splitCount;
+    }
+
+    // Process RSS plus the bytes held by the record/leaf/inner arenas and index
+    MemoryUsage getMemoryUsage() {
+        return MemoryUsage{getMemoryUsageMB(),
+                           recordArena.reservedBytes() + leafArena.reservedBytes() + innerArena.reservedBytes(),
+                           recordArena.liveBytes() + leafArena.liveBytes() + innerArena.liveBytes(),
+                           index.memoryBytes()};
+    }
+
+    // One line per level: separator ranges of inner nodes, then the leaves
+    void printStructure() {
+        if (!root) {
+            cout << "The B+ tree is empty." << endl;
+            return;
+        }
+        cout << "--- B+ Tree Structure (Level View) ---" << endl;
+
+        vector<NodeBase*> level{root};
+        for (int depth = 1; !level.empty(); depth++) {
+            cout << "Level " << depth << ":";
+            vector<NodeBase*> below;
+            for (NodeBase* node : level) {
+                if (node->isLeaf) {
+                    Leaf* leaf = static_cast<Leaf*>(node);
+                    cout << " [" << leaf->keys[0] << ".." << leaf->keys[leaf->count - 1]
+                         << " (" << leaf->count << ")]";
+                } else {
+                    Inner* inner = static_cast<Inner*>(node);
+                    cout << " [";
+                    for (int i = 0; i < inner->count; i++) {
+                        cout << (i ? " " : "") << inner->keys[i];
+                    }
+                    cout << "]";
+                    below.insert(below.end(), inner->children, inner->children + inner->count + 1);
+                }
+            }
+            cout << endl;
+            level.swap(below);
+        }
+        cout << "--------------------------------------" << endl;
+    }
+
+    //////////////////////////////////////////////////////////
+    //////////////// Loading from Data set ///////////////////
+    //////////////////////////////////////////////////////////
+
+    // 30-second sample; returns the projected time for the full dataset, or
+    // the load time if the whole file fit in the sample.
+    // bulkBuild: parse every row first, then buildFromSorted() once at the end
+    double loadFromCSV(const std::string& filename, bool bulkBuild = false) {
+        std::cout << "[B+TREE] Starting CSV load from: " << filename << std::endl;
+
+        vector<Post> parsed;
+        LoadStats stats = PostLoader::readCSV(filename, "[B+TREE]", 30.0,
+            [&](string_view id, long long timestamp, int score) {
+                if (bulkBuild) {
+                    parsed.push_back({string(id), timestamp, score});
+                } else {
+                    insertIterative(string(id), timestamp, score);
+                }
+            });
+        if (!stats.opened) return 0.0;
+        if (bulkBuild) buildFromSorted(std::move(parsed));
+
+        reportLoad("CSV LOAD COMPLETE", stats, 30);
+        return stats.timedOut ? PostLoader::estimateFullLoad(stats) : stats.seconds;
+    }
+
+    void loadFromCSVWithTimeout(const std::string& filename, int timeoutSeconds = 30) {
+        LoadStats stats = PostLoader::readCSV(filename, "[B+TREE]", timeoutSeconds,
+            [this](string_view id, long long timestamp, int score) {
+                insertIterative(string(id), timestamp, score);
+            });
+        reportLoad("CSV LOAD COMPLETE", stats, timeoutSeconds);
+    }
+
+    // Whole CSV parsed on threads cores (0 = all of them) and bulk built, or
+    // as much of it as is parsed within timeLimit seconds
+    ParallelLoadStats loadFromCSVParallel(const std::string& filename, int threads = 0, double timeLimit = 30.0) {
+        std::cout << "[B+TREE] Starting parallel CSV load from: " << filename << std::endl;
+
+        std::vector<Post> parsed;
+        ParallelLoadStats stats = PostLoader::readCSVParallel(filename, "[B+TREE]", timeLimit, threads, parsed);
+        if (!stats.opened) return stats;
+
+        auto buildStart = std::chrono::high_resolution_clock::now();
+        buildFromSorted(std::move(parsed));
+        stats.buildSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - buildStart).count();
+        stats.seconds += stats.buildSeconds;
+
+        reportLoad("PARALLEL CSV LOAD COMPLETE", stats, (int)timeLimit);
+        return stats;
+    }
+
+    // 30-second sample of the zstd JSON dump; returns the projected time for
+    // the full dataset, or the load time if the whole dump fit in the sample.
+    double loadFromTGZ(const std::string& tgzFilename, bool bulkBuild = false) {
+        std::cout << "[B+TREE] Loading from compressed dataset: " << tgzFilename << std::endl;
+
+        vector<Post> parsed;
+        LoadStats stats = PostLoader::readZST(tgzFilename, "[B+TREE]", 30.0, !bulkBuild,
+            [&](string_view id, long long timestamp, int score) {
+                if (bulkBuild) {
+                    parsed.push_back({string(id), timestamp, score});
+                } else {
+                    insertIterative(string(id), timestamp, score);
+                }
+            });
+        if (!stats.opened) return 0.0;
+        if (bulkBuild) buildFromSorted(std::move(parsed));
+
+        reportLoad("LOAD COMPLETE", stats, 30);
+        return stats.timedOut ? PostLoader::estimateFullLoad(stats) : stats.seconds;
+    }
+
+    void loadFromTGZWithTimeout(const std::string& tgzFilename, int timeoutSeconds = 30) {
+        std::cout << "[B+TREE] Starting streaming load..." << std::endl;
+        LoadStats stats = PostLoader::readZST(tgzFilename, "[B+TREE]", timeoutSeconds,
+            [this](string_view id, long long timestamp, int score) {
+                insertIterative(string(id), timestamp, score);
+            });
+        reportLoad("LOAD COMPLETE", stats, timeoutSeconds);
+    }
+
+    // Destructor
+    ~BPlusTree() {
+        clearAll();
+    }
+};
+
+#endif // BPLUS_TREE_H
@@ -6,8 +6,6 @@
 #include <vector>
 #include <fstream>
 #include <algorithm>
-#include <stack>
-#include <queue>
 #include <chrono>
 #include <iomanip>
 #include <sys/resource.h>
@@ -16,30 +14,33 @@
 #include <unistd.h>
 #include <ctime>
 #include <cstring>
+#include <climits>
+#include <limits>
+#include <optional>
+
+#include "Post.h"
+#include "PostIndex.h"
+#include "PostRange.h"
+#include "PostLoader.h"
+#include "FrozenSnapshot.h"
+#include "BasicTreap.h"
 
 using namespace std;
 
 class BinarySearchTree {
 private:
-    struct PostNode {
-        string postId;       // Unique identifier for the post
-        long long timestamp; // Key for BST ordering
-        int score;           // Popularity score
-        PostNode* left;
-        PostNode* right;
-        
-        PostNode(string id, long long ts, int sc) 
-        : postId(id), timestamp(ts), score(sc), left(nullptr), right(nullptr) {}
-    };
-
-    PostNode* root;
-    long long nodeCount;
+    // Plain BST on the shared engine: no heap order (nodes stay where they
+    // are inserted), subtree sizes for order statistics and the
+    // highest-score node of every subtree for the popularity queries. Keys
+    // never repeat (the index refuses a known postId), so DuplicateKeys only
+    // spares the descent its equality test.
+    using Engine = BasicTreap<Post, NoPriority, less<PostKey>, DuplicateKeys,
+                              Augments<SubtreeSize, SubtreeTop<PostScore>>>;
+    using PostNode = Engine::Node;
+
+    Engine engine;                          // Nodes, links and subtree data
     const long long MAX_NODES = 150000000LL; // 150 million safety limit
-
-    int calculateMinHeightHelper(PostNode* node) {
-        if (!node) return 0;
-        return 1 + min(calculateMinHeightHelper(node->left), calculateMinHeightHelper(node->right));
-    }
+    PostIndex<PostNode> index;              // postId -> node, O(1) expected lookup
 
     // Get current memory usage in MB
     long long getMemoryUsageMB() {
@@ -50,247 +51,143 @@ private:
 
     // ITERATIVE insert - prevents stack overflow
     void insertIterative(const string& postId, long long timestamp, int score) {
-        if (nodeCount >= MAX_NODES) {
+        if ((long long)engine.size() >= MAX_NODES) {
             std::cerr << "ERROR: Node limit reached (" << MAX_NODES << " nodes)" << std::endl;
             return;
         }
 
+        // Post IDs are unique - re-adding an existing ID is ignored
+        if (index.find(postId)) return;
+
         try {
-            PostNode* newNode = new PostNode(postId, timestamp, score);
-            
-            if (!root) {
-                root = newNode;
-                nodeCount++;
-                return;
-            }
-            
-            PostNode* current = root;
-            while (true) {
-                if (timestamp < current->timestamp) {
-                    if (!current->left) {
-                        current->left = newNode;
-                        nodeCount++;
-                        break;
-                    }
-                    current = current->left;
-                } else {
-                    // timestamp >= current->timestamp, insert to right
-                    if (!current->right) {
-                        current->right = newNode;
-                        nodeCount++;
-                        break;
-                    }
-                    current = current->right;
-                }
-            }
+            PostNode* newNode = engine.create(postId, timestamp, score);
+            index.insert(newNode);
+            // Composite key (timestamp, postId) descent; sizes and tops are
+            // updated on the way down
+            engine.insert(newNode);
         } catch (const std::bad_alloc& e) {
             std::cerr << "CRITICAL: Memory allocation failed! " << e.what() << std::endl;
             std::cerr << "Current memory usage: " << getMemoryUsageMB() << " MB" << std::endl;
-            std::cerr << "Nodes loaded: " << nodeCount << std::endl;
+            std::cerr << "Nodes loaded: " << engine.size() << std::endl;
             throw;
         }
     }
 
-    // ITERATIVE search by ID
+    // Search by ID through the postId index - O(1) expected
     PostNode* searchByIdIterative(const string& postId) {
-        if (!root) return nullptr;
-        
-        queue<PostNode*> q;
-        q.push(root);
-        
-        while (!q.empty()) {
-            PostNode* node = q.front();
-            q.pop();
-            
-            if (node->postId == postId) {
-                return node;
-            }
-            
-            if (node->left) q.push(node->left);
-            if (node->right) q.push(node->right);
-        }
-        
-        return nullptr;
+        return index.find(postId);
+    }
+
+    // Find a post by its composite key with one descent - O(height)
+    PostNode* findByKeyIterative(long long timestamp, const string& postId) {
+        return engine.find(PostKey(timestamp, postId));
     }
 
     // ITERATIVE delete by ID
     void deleteByIdIterative(const string& postId) {
-        if (!root) return;
-        
-        // BFS to find the node and its parent
-        queue<pair<PostNode*, PostNode*>> q;
-        q.push({root, nullptr});
-        
-        PostNode* targetNode = nullptr;
-        PostNode* targetParent = nullptr;
-        bool targetIsLeft = false;
-        
-        while (!q.empty() && !targetNode) {
-            auto [node, par] = q.front();
-            q.pop();
-            
-            if (node->postId == postId) {
-                targetNode = node;
-                targetParent = par;
-                targetIsLeft = (par && par->left == node);
-                break;
-            }
-            
-            if (node->left) q.push({node->left, node});
-            if (node->right) q.push({node->right, node});
-        }
-        
-        if (!targetNode) return;
-        
-        // Case 1: No children
-        if (!targetNode->left && !targetNode->right) {
-            if (!targetParent) {
-                delete root;
-                root = nullptr;
-            } else if (targetIsLeft) {
-                targetParent->left = nullptr;
-            } else {
-                targetParent->right = nullptr;
-            }
-            delete targetNode;
-            nodeCount--;
-            return;
-        }
-        
-        // Case 2: One child
-        PostNode* child = targetNode->left ? targetNode->left : targetNode->right;
-        if (!targetParent) {
-            root = child;
-        } else if (targetIsLeft) {
-            targetParent->left = child;
-        } else {
-            targetParent->right = child;
-        }
-        delete targetNode;
-        nodeCount--;
+        PostNode* targetNode = index.find(postId);
+        if (targetNode) deleteNodeIterative(targetNode);
     }
 
-    // ITERATIVE height calculation using BFS level counting
-    int getHeightIterative() {
-        if (!root) return 0;
-        
-        queue<pair<PostNode*, int>> q;
-        q.push({root, 1});
-        int maxHeight = 0;
-        
-        while (!q.empty()) {
-            auto [node, height] = q.front();
-            q.pop();
-            
-            maxHeight = max(maxHeight, height);
-            
-            if (node->left) q.push({node->left, height + 1});
-            if (node->right) q.push({node->right, height + 1});
-        }
-        
-        return maxHeight;
+    // Unlink targetNode from the tree (in-order successor splice when it
+    // has two children) and free it - O(height)
+    void deleteNodeIterative(PostNode* targetNode) {
+        index.erase(targetNode->postId);
+        engine.erase(targetNode); // Slot goes on the free list for the next insert
     }
 
-    // ITERATIVE reverse inorder traversal using explicit stack
-    void reverseInorderIterative(int k, vector<string>& result) {
-        if (!root || k <= 0) return;
-        
-        stack<PostNode*> st;
-        PostNode* current = root;
-        
-        // Find rightmost node
-        while (current) {
-            st.push(current);
-            current = current->right;
+    // Number of posts with timestamp < ts (or <= ts when inclusive) - O(height)
+    long long countBeforeIterative(long long ts, bool inclusive) {
+        return engine.countPrefix([ts, inclusive](const PostNode* node) {
+            return node->timestamp < ts || (inclusive && node->timestamp == ts);
+        });
+    }
+
+    // k-th most recent node (1-based): the (n - k)-th in key order - O(height)
+    PostNode* selectByRecencyIterative(long long k) {
+        if (k < 1 || k > (long long)engine.size()) return nullptr;
+        return engine.select(engine.size() - k);
+    }
+
+    // Recency rank of node (1 = most recent) - O(height)
+    long long rankOfIterative(const PostNode* node) {
+        return engine.size() - engine.rankOf(node);
+    }
+
+    // Highest-score node with from <= timestamp <= to - O(height).
+    // Below the node where the two boundary paths split, every in-range
+    // node hangs off one of the paths, either on it or inside a whole
+    // subtree whose top is already known.
+    const PostNode* mostPopularInRangeIterative(long long from, long long to) {
+        const PostNode* node = engine.top();
+        while (node && (node->timestamp < from || node->timestamp > to)) {
+            node = (node->timestamp < from) ? node->right : node->left;
+        }
+        if (!node) return nullptr;
+
+        const PostNode* best = node;
+        auto consider = [&best](const PostNode* candidate) {
+            if (candidate->score > best->score) best = candidate;
+        };
+
+        // Left boundary: nodes >= from contribute themselves and their right subtree
+        for (const PostNode* current = node->left; current; ) {
+            if (current->timestamp >= from) {
+                consider(current);
+                if (current->right) consider(current->right->subtreeTop);
+                current = current->left;
+            } else {
+                current = current->right;
+            }
         }
-        
-        while (!st.empty() && (int)result.size() < k) {
-            current = st.top();
-            st.pop();
-            
-            result.push_back(current->postId + " (TS: " + to_string(current->timestamp) + 
-                           ", Score: " + to_string(current->score) + ")");
-            
-            // Traverse left subtree
-            if (current->left) {
+
+        // Right boundary: nodes <= to contribute themselves and their left subtree
+        for (const PostNode* current = node->right; current; ) {
+            if (current->timestamp <= to) {
+                consider(current);
+                if (current->left) consider(current->left->subtreeTop);
+                current = current->right;
+            } else {
                 current = current->left;
-                while (current) {
-                    st.push(current);
-                    current = current->right;
-                }
             }
         }
+        return best;
     }
 
-    // ITERATIVE find max score post using BFS
-    PostNode* findMaxScorePostIterative() {
-        if (!root) return nullptr;
-        
-        PostNode* maxNode = root;
-        queue<PostNode*> q;
-        q.push(root);
-        
-        while (!q.empty()) {
-            PostNode* node = q.front();
-            q.pop();
-            
-            if (node->score > maxNode->score) {
-                maxNode = node;
-            }
-            
-            if (node->left) q.push(node->left);
-            if (node->right) q.push(node->right);
+    // Result view of a node for the typed queries
+    static PostView viewOf(const PostNode* node) {
+        return PostView{node->postId, node->timestamp, node->score};
+    }
+
+    // Most recent posts: start at the newest node and step to in-order
+    // predecessors through parent links - O(height + k), no stack
+    size_t reverseInorderIterative(int k, PostView* out) {
+        size_t count = 0;
+        const PostNode* node = engine.last();
+        while (node && count < (size_t)max(k, 0)) {
+            out[count++] = viewOf(node);
+            node = PostRange<const PostNode>::predecessor(node);
         }
-        
-        return maxNode;
+        return count;
     }
 
     // ITERATIVE inorder traversal helper
     void inorderIterative() {
-        if (!root) return;
-        
-        stack<PostNode*> st;
-        PostNode* current = root;
-        
-        while (current || !st.empty()) {
-            while (current) {
-                st.push(current);
-                current = current->left;
-            }
-            
-            current = st.top();
-            st.pop();
-            
-            cout << "[" << current->postId << ": T=" << current->timestamp 
-                 << ", S=" << current->score << "] ";
-            
-            current = current->right;
+        for (const PostNode& node : engine) {
+            cout << "[" << node.postId << ": T=" << node.timestamp 
+                 << ", S=" << node.score << "] ";
         }
     }
 
-    // ITERATIVE clear using explicit stack to prevent recursion
+    // ITERATIVE clear: node destructors (postId strings) run without
+    // recursion, then all slabs go back to the system at once
     void clearIterative() {
-        if (!root) return;
-        
-        stack<PostNode*> st;
-        st.push(root);
-        
-        while (!st.empty()) {
-            PostNode* node = st.top();
-            st.pop();
-            
-            if (node->left) st.push(node->left);
-            if (node->right) st.push(node->right);
-            
-            delete node;
-        }
-        
-        root = nullptr;
-        nodeCount = 0;
+        engine.clear();
+        index.clear();
     }
 
 
-    void printVerticalStructure_helper(PostNode* node, const string& prefix, bool isTail, const string& branchLabel) {
+    void printVerticalStructure_helper(const PostNode* node, const string& prefix, bool isTail, const string& branchLabel) {
         if (node == nullptr) {
             return;
         }
@@ -328,7 +225,7 @@ private:
     }
 
 
-    void printVerticalStructure(PostNode* root) {
+    void printVerticalStructure(const PostNode* root) {
         if (root == nullptr) {
             cout << "The tree is empty." << endl;
             return;
@@ -354,16 +251,16 @@ private:
 
 
 public:
-    BinarySearchTree() : root(nullptr), nodeCount(0) {}
+    BinarySearchTree() {}
     
     // calculate minimum height
     int calculateMinHeight() {
-        return calculateMinHeightHelper(root);
+        return engine.getMinHeight();
     }
 
     // Print tree vertical structure
     void printVerticalStructure() {
-        printVerticalStructure(root);
+        printVerticalStructure(engine.top());
     }
 
     // add Post
@@ -378,10 +275,18 @@ public:
     
     // Like Post
     void likePost(const string& postId) {
+        updateScore(postId, 1);
+    }
+
+    // Adjust a post's score by delta and refresh the max-score augmentation
+    // along its ancestors - O(height). Returns false if not found.
+    bool updateScore(const string& postId, int delta) {
         PostNode* node = searchByIdIterative(postId);
-        if (node) {
-            node->score++;
-        }
+        if (!node) return false;
+
+        node->score += delta;
+        engine.changed(node);
+        return true;
     }
     
     // Print post by ID
@@ -397,36 +302,129 @@ public:
         }
     }
 
-    // Get the most popular post (highest score) - O(n)
-    string getMostPopular() {
-        PostNode* maxNode = findMaxScorePostIterative();
+    // Get the most popular post (highest score) - O(1) via the root's subtreeTop
+    optional<PostView> getMostPopular() {
+        const PostNode* maxNode = engine.top() ? engine.top()->subtreeTop : nullptr;
         if (maxNode) {
-            return maxNode->postId + " (Score: " + to_string(maxNode->score) + 
-                   ", Timestamp: " + to_string(maxNode->timestamp) + ")";
+            return viewOf(maxNode);
         }
-        return "No posts found";
+        return nullopt;
+    }
+
+    // Most popular post with from <= timestamp <= to - O(height)
+    optional<PostView> getMostPopularInRange(long long from, long long to) {
+        const PostNode* maxNode = mostPopularInRangeIterative(from, to);
+        if (maxNode) {
+            return viewOf(maxNode);
+        }
+        return nullopt;
     }
     
-    // Get k most recent posts
-    vector<string> getMostRecent(int k) {
-        vector<string> result;
-        reverseInorderIterative(k, result);
-        return result;
+    // k most recent posts, newest first, written to out (room for k) -
+    // returns how many were written
+    size_t getMostRecent(int k, PostView* out) {
+        return reverseInorderIterative(k, out);
     }
     
+    // Replace the tree with a perfectly balanced one built from posts in O(n)
+    // (plus an O(n log n) sort if they are not already in (timestamp, postId) order)
+    void buildFromSorted(vector<Post>&& posts) {
+        clearIterative();
+
+        auto byKey = [](const Post& a, const Post& b) { return postKeyLess(a, b); };
+        if (!is_sorted(posts.begin(), posts.end(), byKey)) {
+            stable_sort(posts.begin(), posts.end(), byKey);
+        }
+
+        vector<PostNode*> nodes;
+        nodes.reserve(posts.size());
+        index.reserve(posts.size());
+        for (Post& post : posts) {
+            if ((long long)nodes.size() >= MAX_NODES) {
+                std::cerr << "ERROR: Node limit reached (" << MAX_NODES << " nodes)" << std::endl;
+                break;
+            }
+            PostNode* node = engine.create(std::move(post));
+            if (!index.insert(node)) {
+                engine.discard(node); // Post IDs are unique - duplicates are ignored
+                continue;
+            }
+            nodes.push_back(node);
+        }
+        posts.clear();
+
+        engine.append(nodes); // Balanced by medians, O(n)
+    }
+
+    // Post with exactly this (timestamp, postId), or nullptr - O(height),
+    // a fast path for callers that know the creation time
+    const PostNode* find(long long timestamp, const string& postId) {
+        return findByKeyIterative(timestamp, postId);
+    }
+
+    // Delete the post with this (timestamp, postId) - O(height).
+    // Returns false if there is no such post.
+    bool erase(long long timestamp, const string& postId) {
+        PostNode* node = findByKeyIterative(timestamp, postId);
+        if (!node) return false;
+        deleteNodeIterative(node);
+        return true;
+    }
+
+    // Number of posts with t1 <= timestamp <= t2 - O(height)
+    long long countInRange(long long t1, long long t2) {
+        if (t1 > t2) return 0;
+        return countBeforeIterative(t2, true) - countBeforeIterative(t1, false);
+    }
+
+    // k-th most recent post (k = 1 is the newest) - O(height)
+    optional<PostView> selectByRecency(long long k) {
+        PostNode* node = selectByRecencyIterative(k);
+        if (node) {
+            return viewOf(node);
+        }
+        return nullopt;
+    }
+
+    // Recency rank of a post (1 = most recent), 0 if not found - O(height)
+    long long rankOf(const string& postId) {
+        PostNode* node = searchByIdIterative(postId);
+        return node ? rankOfIterative(node) : 0;
+    }
+
+    // Posts with from <= timestamp <= to, iterable oldest-first (begin/end)
+    // or newest-first (reversed()) without copying - O(height + k)
+    PostRange<const PostNode> rangeQuery(long long from, long long to) {
+        return PostRange<const PostNode>(engine.top(), from, to);
+    }
+
+    // Pointer-free, read-only copy of the current posts for search-heavy
+    // phases - O(n). Later inserts/deletes are not reflected in it
+    FrozenSnapshot freeze() {
+        return FrozenSnapshot(PostRange<const PostNode>(engine.top(), LLONG_MIN, LLONG_MAX), engine.size());
+    }
+
+    // Top k posts by score with from <= timestamp <= to, highest first,
+    // written to out (room for k) - returns how many were written.
+    // No heap order on score here, so the window is scanned keeping the k
+    // best - O(height + m log k) for m posts in the window
+    size_t topKByScore(long long from, long long to, int k, PostView* out) {
+        return keepTopKByScore(rangeQuery(from, to), k, out);
+    }
+
     // get height of the tree
     int getHeight() {
-        return getHeightIterative();
+        return engine.getHeight();
     }
     
     // get number of nodes
     long long getNodeCount() const {
-        return nodeCount;
+        return engine.size();
     }
     
-    // get memory usage in MB
-    long long getMemoryUsage() {
-        return getMemoryUsageMB();
+    // Process RSS plus the bytes held by this tree's node arena and index
+    MemoryUsage getMemoryUsage() {
+        return MemoryUsage{getMemoryUsageMB(), engine.memoryBytes(), engine.liveBytes(), index.memoryBytes()};
     }
     
     // Utility functions
@@ -441,157 +439,71 @@ public:
     //////////////////////////////////////////////////////////
 
 
-    double loadFromCSV(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Unable to open CSV file: " << filename << std::endl;
-            return 0.0;
-        }
-        
-        std::string line;
-        long long lineCount = 0;
-        double estimatedTotalTime = 0.0;
-
+    // 30-second sample; returns the projected time for the full dataset, or
+    // the load time if the whole file fit in the sample.
+    // bulkBuild: parse every row first, then buildFromSorted() once at the end
+    double loadFromCSV(const std::string& filename, bool bulkBuild = false) {
         std::cout << "[BST] Starting CSV load from: " << filename << std::endl;
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
-        // Skip header line if exists
-        std::getline(file, line);
-        
-        try {
-            while (std::getline(file, line)) {
-                size_t pos1 = line.find(',');
-                size_t pos2 = line.find(',', pos1 + 1);
-                
-                if (pos1 == std::string::npos || pos2 == std::string::npos) {
-                    continue;
-                }
-                
-                std::string id = line.substr(0, pos1);
-                long long timestamp = std::stoll(line.substr(pos1 + 1, pos2 - pos1 - 1));
-                int score = std::stoi(line.substr(pos2 + 1));
-                
-                insertIterative(id, timestamp, score);
-                lineCount++;
-                
-                // Check if 30 seconds passed
-                auto currentTime = std::chrono::high_resolution_clock::now();
-                double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-                
-                if (elapsedSec >= 30.0) {
-                    double rate = lineCount / elapsedSec;
-                    estimatedTotalTime = (134000000.0 / rate); // Estimate for 1M posts
-                    
-                    std::cout << "\n[BST] 30-second sample completed" << std::endl;
-                    std::cout << "[BST] Estimated time for 134M posts: " << std::fixed << std::setprecision(1) 
-                            << estimatedTotalTime << " seconds" << std::endl;
-                    break;
-                }
 
-                // Progress update every 100,000 posts
-                if (lineCount % 100 == 0) {
-                    auto currentTime = std::chrono::high_resolution_clock::now();
-                    double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-                    double rate = lineCount / elapsedSec;
-                    std::cout << "\r[BST] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                              << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s | Memory: " 
-                              << getMemoryUsageMB() << " MB" << std::flush;
+        std::vector<Post> parsed;
+        LoadStats stats = PostLoader::readCSV(filename, "[BST]", 30.0,
+            [&](string_view id, long long timestamp, int score) {
+                if (bulkBuild) {
+                    parsed.push_back({string(id), timestamp, score});
+                } else {
+                    insertIterative(string(id), timestamp, score);
                 }
-            }
-        } catch (const std::bad_alloc& e) {
-            std::cerr << "\n[BST] CRITICAL MEMORY ERROR" << std::endl;
-            std::cerr << "Failed after " << lineCount << " posts" << std::endl;
-            std::cerr << "Memory: " << getMemoryUsageMB() << " MB" << std::endl;
-            file.close();
-            return 0.0;
-        } catch (const std::exception& e) {
-            std::cerr << "\n[BST] Error parsing CSV: " << e.what() << std::endl;
-            file.close();
-            return 0.0;
+            });
+        if (!stats.opened) return 0.0;
+        if (bulkBuild) buildFromSorted(std::move(parsed));
+
+        double estimatedTotalTime = stats.seconds;
+        if (stats.timedOut) {
+            estimatedTotalTime = PostLoader::estimateFullLoad(stats);
+            std::cout << "\n[BST] 30-second sample completed" << std::endl;
+            std::cout << "[BST] Estimated time for 134M posts: " << std::fixed << std::setprecision(1)
+                    << estimatedTotalTime << " seconds" << std::endl;
         }
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
-         
-        std::cout << "\n[BST] Loaded " << lineCount << " posts in " << std::fixed << std::setprecision(3) << totalTime 
+
+        std::cout << "\n[BST] Loaded " << stats.posts << " posts in " << std::fixed << std::setprecision(3) << stats.seconds
                 << "s | Height: " << getHeight() << std::endl;
-        
-        file.close();
 
         return estimatedTotalTime;
     }
 
 
     void loadFromCSVWithTimeout(const std::string& filename, int timeoutSeconds = 30) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Unable to open CSV file: " << filename << std::endl;
-            return;
-        }
+        LoadStats stats = PostLoader::readCSV(filename, "[BST]", timeoutSeconds,
+            [this](string_view id, long long timestamp, int score) {
+                insertIterative(string(id), timestamp, score);
+            });
+        if (!stats.opened) return;
+        if (stats.timedOut) std::cout << "\n[BST] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
 
-        std::string line;
-        long long lineCount = 0;
-        
-        // std::cout << "[BST] Starting CSV load from: " << filename << std::endl;
-        // std::cout << "[BST] Timeout: " << timeoutSeconds << " seconds" << std::endl;
-        
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
-        // Skip header line if exists
-        std::getline(file, line);
-        
-        try {
-            while (std::getline(file, line)) {
-                // Check timeout
-                auto currentTime = std::chrono::high_resolution_clock::now();
-                double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-                if (elapsedSec >= timeoutSeconds) {
-                    std::cout << "\n[BST] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
-                    break;
-                }
-                
-                size_t pos1 = line.find(',');
-                size_t pos2 = line.find(',', pos1 + 1);
-                
-                if (pos1 == std::string::npos || pos2 == std::string::npos) {
-                    continue;
-                }
-                
-                std::string id = line.substr(0, pos1);
-                long long timestamp = std::stoll(line.substr(pos1 + 1, pos2 - pos1 - 1));
-                int score = std::stoi(line.substr(pos2 + 1));
-                
-                insertIterative(id, timestamp, score);
-                lineCount++;
-                
-                // Progress update every 100 posts (changed from 1 for better performance)
-                if (lineCount % 100 == 0) {
-                    double rate = lineCount / elapsedSec;
-                    std::cout << "\r[BST] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                            << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s | " 
-                            << "Remaining: " << (timeoutSeconds - (int)elapsedSec) << "s" << std::flush;
-                }
-            }
-        } catch (const std::bad_alloc& e) {
-            std::cerr << "\n[BST] CRITICAL MEMORY ERROR" << std::endl;
-            std::cerr << "Failed after " << lineCount << " posts" << std::endl;
-            std::cerr << "Memory: " << getMemoryUsageMB() << " MB" << std::endl;
-            file.close();
-            return;
-        } catch (const std::exception& e) {
-            std::cerr << "\n[BST] Error parsing CSV: " << e.what() << std::endl;
-            file.close();
-            return;
-        }
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
-        
         std::cout << "\n ---------- [BST] CSV LOAD COMPLETE ------------" << std::endl;
-        std::cout << "[BST] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(3) << totalTime 
+        std::cout << "[BST] Posts: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3) << stats.seconds
                 << "s | Memory: " << getMemoryUsageMB() << " MB | Height: " << getHeight() << std::endl << std::endl;
-        
-        file.close();
+    }
+
+    // Whole CSV parsed on threads cores (0 = all of them) and bulk built, or
+    // as much of it as is parsed within timeLimit seconds
+    ParallelLoadStats loadFromCSVParallel(const std::string& filename, int threads = 0, double timeLimit = 30.0) {
+        std::cout << "[BST] Starting parallel CSV load from: " << filename << std::endl;
+
+        std::vector<Post> parsed;
+        ParallelLoadStats stats = PostLoader::readCSVParallel(filename, "[BST]", timeLimit, threads, parsed);
+        if (!stats.opened) return stats;
+
+        auto buildStart = std::chrono::high_resolution_clock::now();
+        buildFromSorted(std::move(parsed));
+        stats.buildSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - buildStart).count();
+        stats.seconds += stats.buildSeconds;
+
+        if (stats.timedOut) std::cout << "\n[BST] TIMEOUT after " << timeLimit << " seconds" << std::endl;
+        std::cout << "\n ---------- [BST] PARALLEL CSV LOAD COMPLETE ------------" << std::endl;
+        std::cout << "[BST] Posts: " << stats.posts << " | Threads: " << stats.threads << " | Time: " << std::fixed
+                << std::setprecision(3) << stats.seconds << "s | Height: " << getHeight() << std::endl << std::endl;
+        return stats;
     }
 
     
@@ -643,315 +555,70 @@ public:
     }
 
 
+    // Whole zstd JSON dump, no time limit
     void loadFromZST(const std::string& zstFilename) {
         std::cout << "[BST] Starting ZST stream from: " << zstFilename << std::endl;
-        
-        // Build decompression command
-        std::string streamCmd = "zstd -dc '" + zstFilename + "' 2>/dev/null";
-        FILE* pipe = popen(streamCmd.c_str(), "r");
-        if (!pipe) {
-            std::cerr << "Error: Failed to open ZST file: " << zstFilename << std::endl;
-            return;
-        }
 
-        long long lineCount = 0;
-        std::cout << "[BST] Processing compressed stream..." << std::endl;
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
-        char lineBuffer[65536];
-        
-        try {
-            while (fgets(lineBuffer, sizeof(lineBuffer), pipe) != nullptr) {
-                std::string line(lineBuffer);
-                if (line.empty()) continue;
-                
-                // Parse JSON to extract id, created_utc, and score
-                std::string id, timestamp_str, score_str;
-                
-                // Look for "id":"value"
-                size_t id_pos = line.find("\"id\":\"");
-                if (id_pos != std::string::npos) {
-                    size_t id_start = id_pos + 6;
-                    size_t id_end = line.find("\"", id_start);
-                    if (id_end != std::string::npos) {
-                        id = line.substr(id_start, id_end - id_start);
-                    }
-                }
-                
-                // Look for "created_utc":value (number without quotes)
-                size_t ts_pos = line.find("\"created_utc\":");
-                if (ts_pos != std::string::npos) {
-                    size_t ts_start = ts_pos + 14;
-                    size_t ts_end = line.find(",", ts_start);
-                    if (ts_end != std::string::npos) {
-                        timestamp_str = line.substr(ts_start, ts_end - ts_start);
-                    }
-                }
-                
-                // Look for "score":value (number without quotes)
-                size_t score_pos = line.find("\"score\":");
-                if (score_pos != std::string::npos) {
-                    size_t score_start = score_pos + 8;
-                    size_t score_end = line.find(",", score_start);
-                    if (score_end == std::string::npos) {
-                        score_end = line.find("}", score_start);
-                    }
-                    if (score_end != std::string::npos) {
-                        score_str = line.substr(score_start, score_end - score_start);
-                    }
-                }
-                
-                // Validate and insert
-                if (!id.empty() && !timestamp_str.empty() && !score_str.empty()) {
-                    try {
-                        long long timestamp = std::stoll(timestamp_str);
-                        int score = std::stoi(score_str);
-                        insertIterative(id, timestamp, score);
-                        lineCount++;
-                        
-                        // Progress every 100K posts
-                        if (lineCount % 100 == 0) {
-                            auto currentTime = std::chrono::high_resolution_clock::now();
-                            double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-                            double rate = lineCount / elapsedSec;
-                            std::cout << "\r[BST] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                                      << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s | Memory: " 
-                                      << getMemoryUsageMB() << " MB" << std::flush;
-                        }
-                    } catch (...) {
-                        continue;
-                    }
-                }
-            }
-        } catch (const std::bad_alloc& e) {
-            std::cerr << "\n[BST] MEMORY ERROR after " << lineCount << " posts" << std::endl;
-            pclose(pipe);
-            return;
-        }
-        
-        pclose(pipe);
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
-        
+        LoadStats stats = PostLoader::readZST(zstFilename, "[BST]", numeric_limits<double>::infinity(),
+            [this](string_view id, long long timestamp, int score) {
+                insertIterative(string(id), timestamp, score);
+            });
+        if (!stats.opened) return;
+
         std::cout << "\n[BST] ZST LOAD COMPLETE" << std::endl;
-        std::cout << "[BST] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(3) << totalTime 
+        std::cout << "[BST] Posts: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3) << stats.seconds
                   << "s | Memory: " << getMemoryUsageMB() << " MB | Height: " << getHeight() << std::endl;
     }
 
 
-    double loadFromTGZ(const std::string& tgzFilename) {
+    // 30-second sample of the zstd JSON dump; returns the projected time for
+    // the full dataset, or the load time if the whole dump fit in the sample.
+    // bulkBuild: parse every record first, then buildFromSorted() once at the end
+    double loadFromTGZ(const std::string& tgzFilename, bool bulkBuild = false) {
         std::cout << "[BST] Loading from compressed dataset: " << tgzFilename << std::endl;
-        
-        // Use streaming approach - create a pipe that decompresses on demand
-        std::string cmd = "zstd -dc '" + tgzFilename + "' 2>/dev/null";
-        FILE* f = popen(cmd.c_str(), "r");
-        if (!f) {
-            std::cerr << "[BST] Failed to open pipe" << std::endl;
-            return 0.0;
-        }
-        
-        char buffer[65536];
-        long long lineCount = 0;
-        double estimatedTotalTime = 0.0;
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
         std::cout << "[BST] Starting streaming load..." << std::endl;
-        
-        std::string fullLine;
-        while (fgets(buffer, sizeof(buffer), f) != nullptr) {
-            fullLine += buffer;
-            
-            // Check if 30 seconds passed
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-            
-            if (elapsedSec >= 30.0) {
-                double rate = lineCount / elapsedSec;
-                estimatedTotalTime = (134000000.0 / rate); // Estimate for 1M posts
-                
-                std::cout << "\n[BST] 30-second sample completed" << std::endl;
-                std::cout << "[BST] Estimated time for 134M posts: " << std::fixed << std::setprecision(1) 
-                        << estimatedTotalTime << " seconds" << std::endl;
-                break;
-            }
 
-            // Check if we have a complete JSON object (ends with })
-            size_t pos = fullLine.rfind("}");
-            if (pos != std::string::npos && (pos + 1 >= fullLine.length() || fullLine[pos + 1] == '\n')) {
-                std::string line = fullLine.substr(0, pos + 1);
-                fullLine = (pos + 1 < fullLine.length()) ? fullLine.substr(pos + 1) : "";
-                
-                if (line.empty()) continue;
-                
-                // Parse JSON
-                std::string id, timestamp_str, score_str;
-                
-                size_t id_pos = line.find("\"id\":\"");
-                if (id_pos != std::string::npos) {
-                    size_t id_start = id_pos + 6;
-                    size_t id_end = line.find("\"", id_start);
-                    if (id_end != std::string::npos) {
-                        id = line.substr(id_start, id_end - id_start);
-                    }
-                }
-                
-                size_t ts_pos = line.find("\"created_utc\":");
-                if (ts_pos != std::string::npos) {
-                    size_t ts_start = ts_pos + 14;
-                    size_t ts_end = line.find(",", ts_start);
-                    if (ts_end != std::string::npos) {
-                        timestamp_str = line.substr(ts_start, ts_end - ts_start);
-                    }
-                }
-                
-                size_t score_pos = line.find("\"score\":");
-                if (score_pos != std::string::npos) {
-                    size_t score_start = score_pos + 8;
-                    size_t score_end = line.find(",", score_start);
-                    if (score_end == std::string::npos) {
-                        score_end = line.find("}", score_start);
-                    }
-                    if (score_end != std::string::npos) {
-                        score_str = line.substr(score_start, score_end - score_start);
-                    }
-                }
-                
-                if (!id.empty() && !timestamp_str.empty() && !score_str.empty()) {
-                    try {
-                        long long timestamp = std::stoll(timestamp_str);
-                        int score = std::stoi(score_str);
-                        
-                        insertIterative(id, timestamp, score);
-                        lineCount++;
-                        
-                        if (lineCount % 1000 == 0) {
-                            auto currentTime = std::chrono::high_resolution_clock::now();
-                            double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-                            double rate = lineCount / elapsedSec;
-                            std::cout << "\r[BST] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                                      << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s" 
-                                      << std::flush;
-                        }
-                    } catch (...) {
-                        continue;
-                    }
+        std::vector<Post> parsed;
+        LoadStats stats = PostLoader::readZST(tgzFilename, "[BST]", 30.0, !bulkBuild,
+            [&](string_view id, long long timestamp, int score) {
+                if (bulkBuild) {
+                    parsed.push_back({string(id), timestamp, score});
+                } else {
+                    insertIterative(string(id), timestamp, score);
                 }
-            }
+            });
+        if (!stats.opened) return 0.0;
+        if (bulkBuild) buildFromSorted(std::move(parsed));
+
+        double estimatedTotalTime = stats.seconds;
+        if (stats.timedOut) {
+            estimatedTotalTime = PostLoader::estimateFullLoad(stats);
+            std::cout << "\n[BST] 30-second sample completed" << std::endl;
+            std::cout << "[BST] Estimated time for 134M posts: " << std::fixed << std::setprecision(1)
+                    << estimatedTotalTime << " seconds" << std::endl;
         }
-        
-        pclose(f);
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
-        
+
         std::cout << "\n[BST] LOAD COMPLETE" << std::endl;
-        std::cout << "[BST] Posts Loaded: " << lineCount << " | Time: " << std::fixed << std::setprecision(3) 
-                  << totalTime << "s | Tree Height: " << getHeight() << std::endl;
-    
+        std::cout << "[BST] Posts Loaded: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3)
+                  << stats.seconds << "s | Tree Height: " << getHeight() << std::endl;
+
         return estimatedTotalTime;
     }
 
 
     void loadFromTGZWithTimeout(const std::string& tgzFilename, int timeoutSeconds = 30) {
-        // std::cout << "[BST] Loading from compressed dataset: " << tgzFilename << std::endl;
-        // std::cout << "[BST] Timeout: " << timeoutSeconds << " seconds" << std::endl;
-        
-        // Use streaming approach - create a pipe that decompresses on demand
-        std::string cmd = "zstd -dc '" + tgzFilename + "' 2>/dev/null";
-        FILE* f = popen(cmd.c_str(), "r");
-        if (!f) {
-            std::cerr << "[BST] Failed to open pipe" << std::endl;
-            return;
-        }
-        
-        char buffer[65536];
-        long long lineCount = 0;
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
         std::cout << "[BST] Starting streaming load..." << std::endl;
-        
-        std::string fullLine;
-        while (fgets(buffer, sizeof(buffer), f) != nullptr) {
-            // Check timeout
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-            if (elapsedSec >= timeoutSeconds) {
-                std::cout << "\n[BST] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
-                break;
-            }
-            
-            fullLine += buffer;
-            
-            // Check if we have a complete JSON object (ends with })
-            size_t pos = fullLine.rfind("}");
-            if (pos != std::string::npos && (pos + 1 >= fullLine.length() || fullLine[pos + 1] == '\n')) {
-                std::string line = fullLine.substr(0, pos + 1);
-                fullLine = (pos + 1 < fullLine.length()) ? fullLine.substr(pos + 1) : "";
-                
-                if (line.empty()) continue;
-                
-                // Parse JSON
-                std::string id, timestamp_str, score_str;
-                
-                size_t id_pos = line.find("\"id\":\"");
-                if (id_pos != std::string::npos) {
-                    size_t id_start = id_pos + 6;
-                    size_t id_end = line.find("\"", id_start);
-                    if (id_end != std::string::npos) {
-                        id = line.substr(id_start, id_end - id_start);
-                    }
-                }
-                
-                size_t ts_pos = line.find("\"created_utc\":");
-                if (ts_pos != std::string::npos) {
-                    size_t ts_start = ts_pos + 14;
-                    size_t ts_end = line.find(",", ts_start);
-                    if (ts_end != std::string::npos) {
-                        timestamp_str = line.substr(ts_start, ts_end - ts_start);
-                    }
-                }
-                
-                size_t score_pos = line.find("\"score\":");
-                if (score_pos != std::string::npos) {
-                    size_t score_start = score_pos + 8;
-                    size_t score_end = line.find(",", score_start);
-                    if (score_end == std::string::npos) {
-                        score_end = line.find("}", score_start);
-                    }
-                    if (score_end != std::string::npos) {
-                        score_str = line.substr(score_start, score_end - score_start);
-                    }
-                }
-                
-                if (!id.empty() && !timestamp_str.empty() && !score_str.empty()) {
-                    try {
-                        long long timestamp = std::stoll(timestamp_str);
-                        int score = std::stoi(score_str);
-                        
-                        insertIterative(id, timestamp, score);
-                        lineCount++;
-                        
-                        if (lineCount % 100 == 0) {
-                            double rate = lineCount / elapsedSec;
-                            std::cout << "\r[BST] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                                    << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s" 
-                                    << " | Remaining: " << (timeoutSeconds - (int)elapsedSec) << "s" << std::flush;
-                        }
-                    } catch (...) {
-                        continue;
-                    }
-                }
-            }
-        }
-        
-        pclose(f);
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
-        
+
+        LoadStats stats = PostLoader::readZST(tgzFilename, "[BST]", timeoutSeconds,
+            [this](string_view id, long long timestamp, int score) {
+                insertIterative(string(id), timestamp, score);
+            });
+        if (!stats.opened) return;
+        if (stats.timedOut) std::cout << "\n[BST] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
+
         std::cout << "\n ----------- [BST] LOAD COMPLETE -----------" << std::endl;
-        std::cout << "[BST] Posts Loaded: " << lineCount << " | Time: " << std::fixed << std::setprecision(3) 
-                << totalTime << "s | Tree Height: " << getHeight() << std::endl << std::endl;
+        std::cout << "[BST] Posts Loaded: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3)
+                << stats.seconds << "s | Tree Height: " << getHeight() << std::endl << std::endl;
     }
 
 
@@ -0,0 +1,931 @@
+#ifndef BASIC_TREAP_H
+#define BASIC_TREAP_H
+
+#include <vector>
+#include <queue>
+#include <random>
+#include <thread>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "NodeArena.h"
+#include "PostRange.h"
+
+using namespace std;
+
+// Treap engine behind Treap, BinarySearchTree and any other index
+// (comments, users, ...). A node is the Record itself plus child / parent
+// links and whatever the policies add. Everything that varies is a
+// compile-time policy, so a feature that is not selected leaves no field in
+// the node and no code on the hot path:
+//
+//   Record     - payload every node inherits, ordered by its sortKey()
+//                (Post, or KeyValue<Key, Value> for map-style indexes)
+//   Priority   - heap order over the nodes (RandomPriority,
+//                ValuePriority<Extract>, NoPriority for a plain BST, or a
+//                policy of its own such as Treap's PostPriority)
+//   Compare    - strict weak order on the sort key
+//   Duplicates - UniqueKeys (insert of an existing key is refused) or
+//                DuplicateKeys (equal keys kept, newest after older ones)
+//   Augment    - per-subtree data kept up to date through rotations
+//                (NoAugment, SubtreeSize, SubtreeTop<Extract>, or several
+//                at once with Augments<...>)
+//   Reclaim    - how evicted subtrees are freed (InlineReclaim, or
+//                BackgroundReclaim on a worker thread)
+//
+// Parent links let records change in place and PostRange iterate without a
+// stack; nodes come from a NodeArena. Every walk is iterative, so even a
+// degenerate BST chain cannot overflow the stack.
+
+///////////////////////////////////////////////////////
+////////////////////// Records ////////////////////////
+///////////////////////////////////////////////////////
+
+// Record of a map-style index: key orders the nodes, value rides along
+template <typename Key, typename Value>
+struct KeyValue {
+    Key key;
+    Value value;
+
+    const Key& sortKey() const { return key; }
+};
+
+template <typename Record>
+using SortKeyOf = decay_t<decltype(declval<const Record&>().sortKey())>;
+
+///////////////////////////////////////////////////////
+///////////////// Priority Policies ///////////////////
+///////////////////////////////////////////////////////
+
+// Each supplies Data<Node>, the fields it adds to every node, and
+// Order<Node>, the object the engine keeps: attach() stamps a new node,
+// detach() forgets a removed one, outranks(a, b) is the heap order and
+// changed(node) says whether an updated record has to be re-sifted.
+
+// Independent random priorities: expected O(log n) depth for any key order
+struct RandomPriority {
+    static constexpr bool heapOrdered = true;
+
+    template <typename Node>
+    struct Data {
+        uint32_t priority = 0;
+    };
+
+    template <typename Node>
+    class Order {
+    private:
+        mt19937 rng;
+
+    public:
+        Order() : rng(random_device{}()) {}
+
+        void attach(Node* node) { node->priority = rng(); }
+        void detach(Node*) {}
+        bool changed(Node*) { return false; } // Shape does not depend on the record
+        bool outranks(const Node* a, const Node* b) const { return a->priority > b->priority; }
+        void clear() {}
+    };
+};
+
+// Priority read from the record (e.g. a score): the root holds the largest,
+// and the shape depends on the data
+template <typename Extract>
+struct ValuePriority {
+    static constexpr bool heapOrdered = true;
+
+    template <typename Node>
+    struct Data {};
+
+    template <typename Node>
+    class Order {
+    public:
+        void attach(Node*) {}
+        void detach(Node*) {}
+        bool changed(Node*) { return true; }
+        bool outranks(const Node* a, const Node* b) const { return Extract()(*a) > Extract()(*b); }
+        void clear() {}
+    };
+};
+
+// No heap order at all: nodes stay where they are inserted (plain BST)
+struct NoPriority {
+    static constexpr bool heapOrdered = false;
+
+    template <typename Node>
+    struct Data {};
+
+    template <typename Node>
+    class Order {
+    public:
+        void attach(Node*) {}
+        void detach(Node*) {}
+        bool changed(Node*) { return false; }
+        bool outranks(const Node*, const Node*) const { return false; }
+        void clear() {}
+    };
+};
+
+///////////////////////////////////////////////////////
+//////////////// Duplicate Policies ///////////////////
+///////////////////////////////////////////////////////
+
+struct UniqueKeys {
+    static constexpr bool allowDuplicates = false;
+};
+
+struct DuplicateKeys {
+    static constexpr bool allowDuplicates = true;
+};
+
+///////////////////////////////////////////////////////
+//////////////// Augmentation Policies ////////////////
+///////////////////////////////////////////////////////
+
+// Each supplies Data<Node>, the fields it adds to every node; pull(node),
+// which rebuilds them from the node and its children; and descend(ancestor,
+// node), which accounts for node being linked somewhere below ancestor.
+// fromValue marks data read from the record, redone when the record changes.
+
+struct NoAugment {
+    static constexpr bool fromValue = false;
+
+    template <typename Node>
+    struct Data {};
+
+    template <typename Node>
+    static void pull(Node*) {}
+
+    template <typename Node>
+    static void descend(Node*, Node*) {}
+};
+
+// Node count per subtree - enables select(), rankOf() and countPrefix()
+struct SubtreeSize {
+    static constexpr bool fromValue = false;
+
+    template <typename Node>
+    struct Data {
+        uint32_t subtreeSize = 1;
+    };
+
+    template <typename Node>
+    static void pull(Node* node) {
+        node->subtreeSize = 1 + (node->left ? node->left->subtreeSize : 0) +
+                            (node->right ? node->right->subtreeSize : 0);
+    }
+
+    template <typename Node>
+    static void descend(Node* ancestor, Node*) {
+        ancestor->subtreeSize++;
+    }
+};
+
+// Node with the largest Extract(record) per subtree (the higher node on ties)
+template <typename Extract>
+struct SubtreeTop {
+    static constexpr bool fromValue = true;
+
+    template <typename Node>
+    struct Data {
+        Node* subtreeTop = nullptr;
+    };
+
+    template <typename Node>
+    static void pull(Node* node) {
+        node->subtreeTop = node;
+        if (node->left && Extract()(*node->left->subtreeTop) > Extract()(*node->subtreeTop)) {
+            node->subtreeTop = node->left->subtreeTop;
+        }
+        if (node->right && Extract()(*node->right->subtreeTop) > Extract()(*node->subtreeTop)) {
+            node->subtreeTop = node->right->subtreeTop;
+        }
+    }
+
+    template <typename Node>
+    static void descend(Node* ancestor, Node* node) {
+        if (Extract()(*node) > Extract()(*ancestor->subtreeTop)) ancestor->subtreeTop = node;
+    }
+};
+
+// Several augmentations at once, e.g. Augments<SubtreeSize, SubtreeTop<PostScore>>.
+// Each part's Data becomes its own base of the node (see NodeFields), so a
+// small field can sit in the record's tail padding.
+template <typename... Parts>
+struct Augments {
+    static constexpr bool fromValue = (Parts::fromValue || ...);
+
+    template <typename Node>
+    static void pull(Node* node) {
+        (Parts::pull(node), ...);
+    }
+
+    template <typename Node>
+    static void descend(Node* ancestor, Node* node) {
+        (Parts::descend(ancestor, node), ...);
+    }
+};
+
+///////////////////////////////////////////////////////
+///////////////// Reclaim Policies ////////////////////
+///////////////////////////////////////////////////////
+
+// Destroy a detached subtree without recursion, chaining its slots for the
+// arena. Never touches the arena itself, so it is safe on another thread.
+template <typename Node>
+void retireSubtree(Node* node, typename NodeArena<Node>::FreeChain& chain) {
+    vector<Node*> pending;
+    if (node) pending.push_back(node);
+
+    while (!pending.empty()) {
+        Node* current = pending.back();
+        pending.pop_back();
+        if (current->left) pending.push_back(current->left);
+        if (current->right) pending.push_back(current->right);
+        NodeArena<Node>::retire(current, chain);
+    }
+}
+
+// Evicted subtrees are freed on the caller's thread (background is ignored)
+struct InlineReclaim {
+    template <typename Node>
+    class Reclaimer {
+    private:
+        typename NodeArena<Node>::FreeChain reclaimed;
+
+    public:
+        void retire(Node* subtree, NodeArena<Node>& arena, bool) {
+            retireSubtree(subtree, reclaimed);
+            arena.recycle(reclaimed);
+        }
+
+        void finish(NodeArena<Node>&) {}
+    };
+};
+
+// Evicted subtrees may be freed on a worker thread; their slots become
+// reusable once finish() collects it (next eviction or clear)
+struct BackgroundReclaim {
+    template <typename Node>
+    class Reclaimer {
+    private:
+        thread worker;
+        typename NodeArena<Node>::FreeChain reclaimed; // Slots freed by the worker, not yet reusable
+
+    public:
+        Reclaimer() = default;
+        Reclaimer(const Reclaimer&) = delete;
+        Reclaimer& operator=(const Reclaimer&) = delete;
+
+        ~Reclaimer() {
+            if (worker.joinable()) worker.join();
+        }
+
+        void retire(Node* subtree, NodeArena<Node>& arena, bool background) {
+            finish(arena);
+            if (background) {
+                worker = thread([this, subtree] { retireSubtree(subtree, reclaimed); });
+            } else {
+                retireSubtree(subtree, reclaimed);
+                arena.recycle(reclaimed);
+            }
+        }
+
+        // Wait for the worker and make the slots it freed reusable
+        void finish(NodeArena<Node>& arena) {
+            if (worker.joinable()) worker.join();
+            arena.recycle(reclaimed);
+        }
+    };
+};
+
+///////////////////////////////////////////////////////
+/////////////////////// Engine ////////////////////////
+///////////////////////////////////////////////////////
+
+template <typename... Data>
+struct DataList {};
+
+// The Data each augmentation adds to Node
+template <typename Node, typename Augment>
+struct AugmentData {
+    using type = DataList<typename Augment::template Data<Node>>;
+};
+
+template <typename Node, typename... Parts>
+struct AugmentData<Node, Augments<Parts...>> {
+    using type = DataList<typename Parts::template Data<Node>...>;
+};
+
+// Record and every policy field as sibling bases of one subobject, so the
+// compiler may pack them together (e.g. a 4-byte subtree size into the
+// padding after a post's score)
+template <typename Record, typename AugmentList, typename PriorityData>
+struct NodeFields;
+
+template <typename Record, typename... Augmented, typename PriorityData>
+struct NodeFields<Record, DataList<Augmented...>, PriorityData> : Record, Augmented..., PriorityData {
+    template <typename... Args>
+    explicit NodeFields(Args&&... args) : Record{std::forward<Args>(args)...} {}
+};
+
+template <typename Record,
+          typename Priority = RandomPriority,
+          typename Compare = less<SortKeyOf<Record>>,
+          typename Duplicates = UniqueKeys,
+          typename Augment = NoAugment,
+          typename Reclaim = InlineReclaim>
+class BasicTreap {
+public:
+    using Key = SortKeyOf<Record>;
+
+    struct Node : NodeFields<Record, typename AugmentData<Node, Augment>::type, typename Priority::template Data<Node>> {
+        Node* left = nullptr;
+        Node* right = nullptr;
+        Node* parent = nullptr;
+
+        template <typename... Args>
+        explicit Node(Args&&... args)
+            : NodeFields<Record, typename AugmentData<Node, Augment>::type, typename Priority::template Data<Node>>(
+                  std::forward<Args>(args)...) {}
+    };
+
+    using PriorityOrder = typename Priority::template Order<Node>;
+
+    // In-order iterator over const nodes
+    class Iterator {
+    private:
+        const Node* node;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = Node;
+        using difference_type = ptrdiff_t;
+        using pointer = const Node*;
+        using reference = const Node&;
+
+        explicit Iterator(const Node* n = nullptr) : node(n) {}
+
+        reference operator*() const { return *node; }
+        pointer operator->() const { return node; }
+
+        Iterator& operator++() {
+            node = PostRange<const Node>::successor(node);
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+    };
+
+private:
+    static constexpr bool augmented = !is_same<Augment, NoAugment>::value;
+    static constexpr bool hasSize = is_base_of<SubtreeSize::Data<Node>, Node>::value;
+
+    Node* root;
+    size_t nodeCount;
+    long long rotationCount;
+    PriorityOrder order;
+    Compare less_;
+    NodeArena<Node> arena;
+    typename Reclaim::template Reclaimer<Node> reclaimer;
+
+    static size_t sizeOf(const Node* node) {
+        return node ? node->subtreeSize : 0;
+    }
+
+    // Rebuild augmented data from node up to the root - O(depth)
+    void pullUp(Node* node) {
+        if constexpr (augmented) {
+            for (; node; node = node->parent) Augment::pull(node);
+        }
+    }
+
+    // Rebuild augmented data along a spine, deepest node first
+    static void pullSpine(vector<Node*>& spine) {
+        if constexpr (augmented) {
+            for (size_t i = spine.size(); i > 0; i--) Augment::pull(spine[i - 1]);
+        }
+    }
+
+    ///////////////////////////////////////////////////////
+    ///////////////////// Rotations ///////////////////////
+    ///////////////////////////////////////////////////////
+
+    // The link (root or the parent's child pointer) that holds node
+    Node*& linkOf(Node* node) {
+        if (!node->parent) return root;
+        return node->parent->left == node ? node->parent->left : node->parent->right;
+    }
+
+    // Lift child above its parent (left or right rotation as needed)
+    void rotateUp(Node* child) {
+        Node* node = child->parent;
+        linkOf(node) = child;
+        child->parent = node->parent;
+
+        if (node->left == child) {
+            node->left = child->right;
+            if (node->left) node->left->parent = node;
+            child->right = node;
+        } else {
+            node->right = child->left;
+            if (node->right) node->right->parent = node;
+            child->left = node;
+        }
+        node->parent = child;
+        rotationCount++;
+
+        Augment::pull(node);
+        Augment::pull(child);
+    }
+
+    // Rotate node upward while it outranks its parent - O(depth)
+    void siftUp(Node* node) {
+        while (node->parent && order.outranks(node, node->parent)) {
+            rotateUp(node);
+        }
+    }
+
+    // Rotate node downward while a child outranks it - O(depth)
+    void siftDown(Node* node) {
+        while (true) {
+            Node* best = node->left;
+            if (node->right && (!best || order.outranks(node->right, best))) best = node->right;
+            if (!best || !order.outranks(best, node)) break;
+            rotateUp(best);
+        }
+    }
+
+    // Take node out of the tree; returns the lowest node whose subtree lost it
+    Node* unlink(Node* node) {
+        if constexpr (Priority::heapOrdered) {
+            // Rotate down until at most one child remains (the higher-priority child moves up)
+            while (node->left && node->right) {
+                rotateUp(order.outranks(node->left, node->right) ? node->left : node->right);
+            }
+        } else if (node->left && node->right) {
+            // Two children: splice in the in-order successor (leftmost of right subtree)
+            Node* successor = PostRange<Node>::leftmost(node->right);
+            Node* changedFrom = (successor->parent == node) ? successor : successor->parent;
+            linkOf(successor) = successor->right;
+            if (successor->right) successor->right->parent = successor->parent;
+
+            successor->left = node->left;
+            successor->right = node->right;
+            successor->left->parent = successor;
+            if (successor->right) successor->right->parent = successor;
+
+            successor->parent = node->parent;
+            linkOf(node) = successor;
+            return changedFrom;
+        }
+
+        // Zero or one child: lift the child into the node's place
+        Node* child = node->left ? node->left : node->right;
+        if (child) child->parent = node->parent;
+        linkOf(node) = child;
+        return node->parent;
+    }
+
+    ///////////////////////////////////////////////////////
+    ///////////////////// Split / Merge ///////////////////
+    ///////////////////////////////////////////////////////
+
+    // Split node's subtree into left (nodes with goesLeft(node)) and right
+    // (the rest); goesLeft must hold for a prefix of the key order.
+    // Top-down along one path, so O(depth) and no recursion.
+    template <typename GoesLeft>
+    void splitWhere(Node* node, GoesLeft goesLeft, Node*& left, Node*& right) {
+        Node** leftLink = &left;
+        Node** rightLink = &right;
+        Node* leftParent = nullptr;
+        Node* rightParent = nullptr;
+        vector<Node*> spine;
+
+        while (node) {
+            spine.push_back(node);
+            if (goesLeft(node)) {
+                *leftLink = node;
+                node->parent = leftParent;
+                leftParent = node;
+                leftLink = &node->right;
+                node = node->right;
+            } else {
+                *rightLink = node;
+                node->parent = rightParent;
+                rightParent = node;
+                rightLink = &node->left;
+                node = node->left;
+            }
+        }
+        *leftLink = nullptr;
+        *rightLink = nullptr;
+
+        pullSpine(spine);
+    }
+
+    // Merge two trees where every key in left < every key in right.
+    // Walks the right spine of left / left spine of right - O(depth).
+    Node* merge(Node* left, Node* right) {
+        Node* merged = nullptr;
+        Node** link = &merged;
+        Node* parent = nullptr;
+        vector<Node*> spine;
+
+        while (left && right) {
+            if (!order.outranks(right, left)) {
+                *link = left;
+                left->parent = parent;
+                parent = left;
+                link = &left->right;
+                spine.push_back(left);
+                left = left->right;
+            } else {
+                *link = right;
+                right->parent = parent;
+                parent = right;
+                link = &right->left;
+                spine.push_back(right);
+                right = right->left;
+            }
+        }
+
+        Node* rest = left ? left : right;
+        *link = rest;
+        if (rest) rest->parent = parent;
+
+        pullSpine(spine);
+        return merged;
+    }
+
+    ///////////////////////////////////////////////////////
+    //////////////////// Bulk Building ////////////////////
+    ///////////////////////////////////////////////////////
+
+    // Heap-ordered tree from key-sorted nodes in O(n): the classic
+    // stack-based Cartesian tree construction. The stack is the right spine;
+    // each new node pops every spine node it outranks and adopts them as its
+    // left subtree. A popped node's subtree is final, so its data is too.
+    Node* buildCartesian(vector<Node*>& nodes) {
+        vector<Node*> spine;
+
+        for (Node* node : nodes) {
+            Node* last = nullptr;
+            while (!spine.empty() && order.outranks(node, spine.back())) {
+                last = spine.back();
+                spine.pop_back();
+                Augment::pull(last);
+            }
+
+            node->left = last;
+            if (last) last->parent = node;
+            if (!spine.empty()) {
+                spine.back()->right = node;
+                node->parent = spine.back();
+            }
+            spine.push_back(node);
+        }
+
+        pullSpine(spine);
+        return spine.empty() ? nullptr : spine.front();
+    }
+
+    // Perfectly balanced tree from key-sorted nodes (medians on top) - O(n)
+    Node* buildBalanced(vector<Node*>& nodes) {
+        struct Range {
+            long long lo, hi; // Inclusive bounds into nodes
+            Node* parent;
+            Node** link;
+        };
+
+        Node* subtree = nullptr;
+        vector<Range> pending;
+        vector<Node*> preorder; // Parents before children
+        preorder.reserve(nodes.size());
+        if (!nodes.empty()) pending.push_back({0, (long long)nodes.size() - 1, nullptr, &subtree});
+
+        while (!pending.empty()) {
+            Range r = pending.back();
+            pending.pop_back();
+
+            long long mid = r.lo + (r.hi - r.lo) / 2;
+            Node* node = nodes[mid];
+            node->parent = r.parent;
+            *r.link = node;
+            preorder.push_back(node);
+
+            if (mid > r.lo) pending.push_back({r.lo, mid - 1, node, &node->left});
+            if (mid < r.hi) pending.push_back({mid + 1, r.hi, node, &node->right});
+        }
+
+        // Children before parents for the augmented data
+        pullSpine(preorder);
+        return subtree;
+    }
+
+public:
+    BasicTreap() : root(nullptr), nodeCount(0), rotationCount(0) {}
+
+    // Start with a configured priority order (e.g. a run-time mode)
+    explicit BasicTreap(PriorityOrder priorityOrder)
+        : root(nullptr), nodeCount(0), rotationCount(0), order(std::move(priorityOrder)) {}
+
+    BasicTreap(const BasicTreap&) = delete;
+    BasicTreap& operator=(const BasicTreap&) = delete;
+
+    ~BasicTreap() {
+        clear();
+    }
+
+    ///////////////////////////////////////////////////////
+    /////////////////// Insert / Erase ////////////////////
+    ///////////////////////////////////////////////////////
+
+    // New unlinked node built from the record fields (or a whole Record)
+    template <typename... Args>
+    Node* create(Args&&... args) {
+        Node* node = arena.create(std::forward<Args>(args)...);
+        Augment::pull(node);
+        order.attach(node);
+        return node;
+    }
+
+    // Free a node from create() that was never linked
+    void discard(Node* node) {
+        order.detach(node);
+        arena.destroy(node);
+    }
+
+    // Link a node from create() as a leaf by its key, then sift it up -
+    // O(log n) expected. Under UniqueKeys an existing key wins: that node is
+    // returned with false, and node is left for discard().
+    pair<Node*, bool> insert(Node* node) {
+        const auto& key = node->sortKey();
+        Node* parent = nullptr;
+        Node** link = &root;
+        while (*link) {
+            parent = *link;
+            bool goLeft = less_(key, parent->sortKey());
+            if constexpr (Duplicates::allowDuplicates) {
+                Augment::descend(parent, node);
+            } else if (!goLeft && !less_(parent->sortKey(), key)) {
+                return {parent, false};
+            }
+            link = goLeft ? &parent->left : &parent->right;
+        }
+        *link = node;
+        node->parent = parent;
+        nodeCount++;
+
+        if constexpr (!Duplicates::allowDuplicates && augmented) {
+            for (Node* ancestor = parent; ancestor; ancestor = ancestor->parent) {
+                Augment::descend(ancestor, node);
+            }
+        }
+        if constexpr (Priority::heapOrdered) siftUp(node);
+        return {node, true};
+    }
+
+    // create() + insert(), discarding the new node if its key is refused
+    template <typename... Args>
+    pair<Node*, bool> emplace(Args&&... args) {
+        Node* node = create(std::forward<Args>(args)...);
+        pair<Node*, bool> result = insert(node);
+        if (!result.second) discard(node);
+        return result;
+    }
+
+    // Link a node from create() by splitting the tree at its key and
+    // merging the parts back - O(log n) expected, no rotations. Does not
+    // check UniqueKeys.
+    void insertBySplit(Node* node) {
+        const auto& key = node->sortKey();
+        Node* left = nullptr;
+        Node* right = nullptr;
+        splitWhere(root, [&](const Node* n) { return !less_(key, n->sortKey()); }, left, right);
+        root = merge(merge(left, node), right);
+        nodeCount++;
+    }
+
+    // Link nodes from create(), sorted by key and all after the current
+    // last key: they are built into one subtree in O(n) - a Cartesian tree
+    // by priority, or balanced by medians without one - and merged on
+    void append(vector<Node*>& sorted) {
+        Node* subtree;
+        if constexpr (Priority::heapOrdered) {
+            subtree = buildCartesian(sorted);
+        } else {
+            subtree = buildBalanced(sorted);
+        }
+        root = merge(root, subtree);
+        nodeCount += sorted.size();
+    }
+
+    // Remove one node - O(log n) expected
+    void erase(Node* node) {
+        pullUp(unlink(node));
+        discard(node);
+        nodeCount--;
+    }
+
+    // Remove the node with this key (the oldest one under DuplicateKeys)
+    bool erase(const Key& key) {
+        Node* node = lowerBound(key);
+        if (!node || less_(key, node->sortKey())) return false;
+        erase(node);
+        return true;
+    }
+
+    // Bring the tree back in line after node's record changed in place (its
+    // key must not): record-derived augmented data is redone and, if the
+    // priority moved, the node is re-sifted - O(log n) expected
+    void changed(Node* node) {
+        if constexpr (Augment::fromValue) pullUp(node);
+        if constexpr (Priority::heapOrdered) {
+            if (order.changed(node)) {
+                siftUp(node);
+                siftDown(node);
+            }
+        } else {
+            order.changed(node);
+        }
+    }
+
+    // Split off every node with goesLeft(node) - a prefix of the key order -
+    // in O(log n), show each to visit (e.g. to drop it from a side index),
+    // then free them in bulk: here, or on the Reclaim policy's worker if
+    // background. Returns the number of evicted nodes.
+    template <typename GoesLeft, typename Visit>
+    size_t evictPrefix(GoesLeft goesLeft, Visit visit, bool background = false) {
+        Node* evicted = nullptr;
+        splitWhere(root, goesLeft, evicted, root);
+
+        size_t count = 0;
+        vector<Node*> pending;
+        if (evicted) pending.push_back(evicted);
+        while (!pending.empty()) {
+            Node* node = pending.back();
+            pending.pop_back();
+            if (node->left) pending.push_back(node->left);
+            if (node->right) pending.push_back(node->right);
+
+            order.detach(node);
+            visit(static_cast<const Node*>(node));
+            count++;
+        }
+        nodeCount -= count;
+
+        reclaimer.retire(evicted, arena, background);
+        return count;
+    }
+
+    ///////////////////////////////////////////////////////
+    ////////////////////// Queries ////////////////////////
+    ///////////////////////////////////////////////////////
+
+    // Node with this key, or nullptr - O(log n) expected
+    Node* find(const Key& key) const {
+        Node* node = lowerBound(key);
+        return node && !less_(key, node->sortKey()) ? node : nullptr;
+    }
+
+    // First node with key >= key, or nullptr
+    Node* lowerBound(const Key& key) const {
+        Node* found = nullptr;
+        for (Node* current = root; current; ) {
+            if (less_(current->sortKey(), key)) {
+                current = current->right;
+            } else {
+                found = current;
+                current = current->left;
+            }
+        }
+        return found;
+    }
+
+    // Number of nodes with goesLeft(node), a prefix of the key order -
+    // O(log n), needs SubtreeSize
+    template <typename GoesLeft>
+    size_t countPrefix(GoesLeft goesLeft) const {
+        static_assert(hasSize, "countPrefix() needs the SubtreeSize augmentation");
+        size_t count = 0;
+        for (const Node* node = root; node; ) {
+            if (goesLeft(node)) {
+                count += sizeOf(node->left) + 1;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+        return count;
+    }
+
+    // k-th node in key order, 0-based - needs SubtreeSize
+    Node* select(size_t k) const {
+        static_assert(hasSize, "select() needs the SubtreeSize augmentation");
+        Node* current = root;
+        while (current) {
+            size_t leftSize = sizeOf(current->left);
+            if (k < leftSize) {
+                current = current->left;
+            } else if (k == leftSize) {
+                return current;
+            } else {
+                k -= leftSize + 1;
+                current = current->right;
+            }
+        }
+        return nullptr;
+    }
+
+    // Position of node in key order, 0-based - needs SubtreeSize
+    size_t rankOf(const Node* node) const {
+        static_assert(hasSize, "rankOf() needs the SubtreeSize augmentation");
+        size_t rank = sizeOf(node->left);
+        for (; node->parent; node = node->parent) {
+            if (node->parent->right == node) {
+                rank += 1 + sizeOf(node->parent->left);
+            }
+        }
+        return rank;
+    }
+
+    // Root node: the highest priority, and whole-tree augmented data
+    const Node* top() const { return root; }
+
+    const Node* first() const { return PostRange<const Node>::leftmost(root); }
+    const Node* last() const { return PostRange<const Node>::rightmost(root); }
+
+    Iterator begin() const { return Iterator(first()); }
+    Iterator end() const { return Iterator(); }
+
+    const PriorityOrder& priorityOrder() const { return order; }
+
+    size_t size() const { return nodeCount; }
+    bool empty() const { return nodeCount == 0; }
+
+    long long getRotationCount() const { return rotationCount; }
+    void resetRotationCount() { rotationCount = 0; }
+
+    // Height via DFS with an explicit stack
+    int getHeight() const {
+        int height = 0;
+        vector<pair<const Node*, int>> pending;
+        if (root) pending.push_back({root, 1});
+        while (!pending.empty()) {
+            auto [node, depth] = pending.back();
+            pending.pop_back();
+            height = max(height, depth);
+            if (node->left) pending.push_back({node->left, depth + 1});
+            if (node->right) pending.push_back({node->right, depth + 1});
+        }
+        return height;
+    }
+
+    // Depth of the shallowest missing child: BFS stops at the first node
+    // lacking one, so no recursion depth proportional to the tree height
+    int getMinHeight() const {
+        if (!root) return 0;
+
+        queue<pair<const Node*, int>> q;
+        q.push({root, 1});
+        while (true) {
+            auto [node, depth] = q.front();
+            q.pop();
+            if (!node->left || !node->right) return depth;
+            q.push({node->left, depth + 1});
+            q.push({node->right, depth + 1});
+        }
+    }
+
+    // Slab memory reserved by the node arena, and the part of it in use
+    size_t memoryBytes() const { return arena.reservedBytes(); }
+    size_t liveBytes() const { return arena.liveBytes(); }
+
+    // Run node destructors if the record needs them, then hand all slabs
+    // back at once
+    void clear() {
+        reclaimer.finish(arena);
+        if (root && arena.needsDestructor()) {
+            vector<Node*> pending;
+            pending.push_back(root);
+            while (!pending.empty()) {
+                Node* node = pending.back();
+                pending.pop_back();
+                if (node->left) pending.push_back(node->left);
+                if (node->right) pending.push_back(node->right);
+                node->~Node();
+            }
+        }
+        arena.release();
+        order.clear();
+        root = nullptr;
+        nodeCount = 0;
+    }
+};
+
+#endif // BASIC_TREAP_H
@@ -0,0 +1,656 @@
+#ifndef COMPACT_TREAP_H
+#define COMPACT_TREAP_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <string_view>
+#include <limits>
+#include <sys/resource.h>
+
+#include "Post.h"
+#include "PackedId.h"
+#include "NodeArena.h"
+#include "PostLoader.h"
+
+using namespace std;
+
+///////////////////////////////////////////////////////
+/////////////////////// Node Layouts //////////////////
+///////////////////////////////////////////////////////
+
+// Both layouts hold the same 24 bytes per post - packed ID, 32-bit
+// timestamp, score and two 32-bit child indices - addressed by node index,
+// with index 0 reserved as the NIL sentinel. They differ only in how those
+// fields sit in memory.
+
+// One array of whole nodes: a post's fields share a cache line, which
+// suits operations that touch every field of a few nodes (insert, delete)
+struct PackedLayout {
+    struct CompactNode {
+        uint64_t id;        // PackedId
+        uint32_t timestamp; // Unix seconds (fits until 2106)
+        int32_t score;      // Popularity score (heap priority)
+        uint32_t left;      // Index into nodes (0 = none); next free slot when unused
+        uint32_t right;
+    };
+    static_assert(sizeof(CompactNode) == 24, "CompactNode must stay 24 bytes");
+
+    static constexpr size_t NODE_BYTES = sizeof(CompactNode);
+
+    vector<CompactNode> nodes;
+
+    uint64_t& id(uint32_t n) { return nodes[n].id; }
+    uint32_t& timestamp(uint32_t n) { return nodes[n].timestamp; }
+    int32_t& score(uint32_t n) { return nodes[n].score; }
+    uint32_t& left(uint32_t n) { return nodes[n].left; }
+    uint32_t& right(uint32_t n) { return nodes[n].right; }
+    uint64_t id(uint32_t n) const { return nodes[n].id; }
+    uint32_t timestamp(uint32_t n) const { return nodes[n].timestamp; }
+    int32_t score(uint32_t n) const { return nodes[n].score; }
+    uint32_t left(uint32_t n) const { return nodes[n].left; }
+    uint32_t right(uint32_t n) const { return nodes[n].right; }
+
+    size_t size() const { return nodes.size(); }
+    void reserve(size_t n) { nodes.reserve(n); }
+
+    // Drop every node but the sentinel
+    void reset() { nodes.assign(1, CompactNode{0, 0, 0, 0, 0}); }
+
+    // Append a childless node, returning its index
+    uint32_t push(uint64_t id, uint32_t timestamp, int32_t score) {
+        nodes.push_back(CompactNode{id, timestamp, score, 0, 0});
+        return (uint32_t)nodes.size() - 1;
+    }
+
+    // Reuse slot n for a childless node
+    void set(uint32_t n, uint64_t id, uint32_t timestamp, int32_t score) {
+        nodes[n] = CompactNode{id, timestamp, score, 0, 0};
+    }
+
+    void copy(uint32_t to, uint32_t from) { nodes[to] = nodes[from]; }
+
+    // Keep nodes [0, n) and give back the spare capacity
+    void truncate(size_t n) {
+        nodes.resize(n);
+        nodes.shrink_to_fit();
+    }
+
+    // Sort nodes [1, size()) by the composite key (timestamp, id)
+    void sortByKey() {
+        sort(nodes.begin() + 1, nodes.end(), [](const CompactNode& a, const CompactNode& b) {
+            return a.timestamp != b.timestamp ? a.timestamp < b.timestamp : a.id < b.id;
+        });
+    }
+
+    size_t reservedBytes() const { return nodes.capacity() * NODE_BYTES; }
+};
+
+// One array per field: traversals that read only links (height) or keys
+// and links (search by timestamp) stream through 8 or 12 bytes per node
+// instead of pulling in all 24
+struct SplitLayout {
+    struct Links {
+        uint32_t left;  // Index of the left child (0 = none); next free slot when unused
+        uint32_t right;
+    };
+
+    static constexpr size_t NODE_BYTES = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(int32_t) + sizeof(Links);
+
+    vector<uint64_t> ids;
+    vector<uint32_t> timestamps;
+    vector<int32_t> scores;
+    vector<Links> links;
+
+    uint64_t& id(uint32_t n) { return ids[n]; }
+    uint32_t& timestamp(uint32_t n) { return timestamps[n]; }
+    int32_t& score(uint32_t n) { return scores[n]; }
+    uint32_t& left(uint32_t n) { return links[n].left; }
+    uint32_t& right(uint32_t n) { return links[n].right; }
+    uint64_t id(uint32_t n) const { return ids[n]; }
+    uint32_t timestamp(uint32_t n) const { return timestamps[n]; }
+    int32_t score(uint32_t n) const { return scores[n]; }
+    uint32_t left(uint32_t n) const { return links[n].left; }
+    uint32_t right(uint32_t n) const { return links[n].right; }
+
+    size_t size() const { return ids.size(); }
+
+    void reserve(size_t n) {
+        ids.reserve(n);
+        timestamps.reserve(n);
+        scores.reserve(n);
+        links.reserve(n);
+    }
+
+    void reset() {
+        ids.assign(1, 0);
+        timestamps.assign(1, 0);
+        scores.assign(1, 0);
+        links.assign(1, Links{0, 0});
+    }
+
+    uint32_t push(uint64_t id, uint32_t timestamp, int32_t score) {
+        ids.push_back(id);
+        timestamps.push_back(timestamp);
+        scores.push_back(score);
+        links.push_back(Links{0, 0});
+        return (uint32_t)ids.size() - 1;
+    }
+
+    void set(uint32_t n, uint64_t id, uint32_t timestamp, int32_t score) {
+        ids[n] = id;
+        timestamps[n] = timestamp;
+        scores[n] = score;
+        links[n] = Links{0, 0};
+    }
+
+    void copy(uint32_t to, uint32_t from) {
+        ids[to] = ids[from];
+        timestamps[to] = timestamps[from];
+        scores[to] = scores[from];
+        links[to] = links[from];
+    }
+
+    void truncate(size_t n) {
+        ids.resize(n);
+        timestamps.resize(n);
+        scores.resize(n);
+        links.resize(n);
+        ids.shrink_to_fit();
+        timestamps.shrink_to_fit();
+        scores.shrink_to_fit();
+        links.shrink_to_fit();
+    }
+
+    // Sort an index permutation by key, then gather each field through it
+    void sortByKey() {
+        vector<uint32_t> order(ids.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin() + 1, order.end(), [this](uint32_t a, uint32_t b) {
+            return timestamps[a] != timestamps[b] ? timestamps[a] < timestamps[b] : ids[a] < ids[b];
+        });
+        gather(ids, order);
+        gather(timestamps, order);
+        gather(scores, order);
+        gather(links, order);
+    }
+
+    template <typename T>
+    static void gather(vector<T>& field, const vector<uint32_t>& order) {
+        vector<T> sorted(order.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            sorted[i] = field[order[i]];
+        }
+        field.swap(sorted);
+    }
+
+    size_t reservedBytes() const {
+        return ids.capacity() * sizeof(uint64_t) + timestamps.capacity() * sizeof(uint32_t) +
+               scores.capacity() * sizeof(int32_t) + links.capacity() * sizeof(Links);
+    }
+};
+
+// Memory-lean treap for holding the full dataset in RAM.
+// Each post takes 24 bytes of node storage: packed ID, 32-bit timestamp,
+// score and two 32-bit child indices, laid out by the Layout policy above
+// - no std::string, no per-node allocation, no parent pointer. Posts are
+// ordered by the composite key (timestamp, id), which is unique, so any
+// node can be reached from the root by key alone; the root-to-node path
+// stands in for parent links.
+// Heap priority is the score (root = most popular post), with a hash of the
+// ID breaking ties so equal scores still give a balanced shape.
+// IDs are converted back to strings only when a post is printed.
+template <typename Layout>
+class BasicCompactTreap {
+private:
+    static constexpr uint32_t NIL = 0; // Node 0 is a sentinel, never a post
+
+    Layout nodes;
+    uint32_t freeHead;       // Free-list of deleted slots, chained through left
+    uint32_t root;
+    long long nodeCount;
+    long long rotationCount;
+    vector<uint32_t> slots;  // ID index: open addressing over node indices (0 = empty)
+    size_t mask;
+    vector<uint32_t> path;   // Root-to-node path, reused between operations
+    string viewIds;          // IDs unpacked for the PostViews of the last query
+
+    static constexpr size_t INITIAL_SLOTS = 16;
+
+    ///////////////////////////////////////////////////////
+    ////////////////////// ID Index ///////////////////////
+    ///////////////////////////////////////////////////////
+
+    // Locate the slot holding id, or the empty slot where it would go
+    size_t probe(uint64_t id) const {
+        size_t i = PackedId::mix(id) & mask;
+        while (slots[i] && nodes.id(slots[i]) != id) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash(size_t newCapacity) {
+        vector<uint32_t> old;
+        old.swap(slots);
+        slots.assign(newCapacity, NIL);
+        mask = newCapacity - 1;
+        for (uint32_t n : old) {
+            if (n) slots[probe(nodes.id(n))] = n;
+        }
+    }
+
+    void reserveIndex(size_t n) {
+        size_t capacity = slots.size();
+        while (n * 10 > capacity * 7) capacity *= 2;
+        if (capacity != slots.size()) rehash(capacity);
+    }
+
+    uint32_t findNode(uint64_t id) const {
+        return id ? slots[probe(id)] : NIL;
+    }
+
+    // Register node n; returns false if its ID is already indexed
+    bool indexInsert(uint32_t n) {
+        reserveIndex(nodeCount + 1);
+        size_t i = probe(nodes.id(n));
+        if (slots[i]) return false;
+        slots[i] = n;
+        return true;
+    }
+
+    // Backward-shift deletion, as in PostIndex
+    void indexErase(uint64_t id) {
+        size_t i = probe(id);
+        if (!slots[i]) return;
+
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!slots[j]) break;
+            size_t home = PackedId::mix(nodes.id(slots[j])) & mask;
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i] = NIL;
+    }
+
+    ///////////////////////////////////////////////////////
+    ////////////////////// Helpers ////////////////////////
+    ///////////////////////////////////////////////////////
+
+    // Composite key order: timestamp, then packed ID (string order, as in
+    // postKeyLess)
+    bool precedes(uint32_t a, uint32_t b) const {
+        if (nodes.timestamp(a) != nodes.timestamp(b)) return nodes.timestamp(a) < nodes.timestamp(b);
+        return nodes.id(a) < nodes.id(b);
+    }
+
+    // Heap order: higher score wins, ID hash breaks ties
+    bool outranks(uint32_t a, uint32_t b) const {
+        if (nodes.score(a) != nodes.score(b)) return nodes.score(a) > nodes.score(b);
+        return PackedId::mix(nodes.id(a)) > PackedId::mix(nodes.id(b));
+    }
+
+    uint32_t allocate(uint64_t id, uint32_t timestamp, int32_t score) {
+        uint32_t n = freeHead;
+        if (n) {
+            freeHead = nodes.left(n);
+            nodes.set(n, id, timestamp, score);
+        } else {
+            n = nodes.push(id, timestamp, score);
+        }
+        return n;
+    }
+
+    void release(uint32_t n) {
+        nodes.left(n) = freeHead;
+        freeHead = n;
+    }
+
+    // Fill path with the ancestors of n (root first, parent last) - O(depth)
+    void findPath(uint32_t n) {
+        path.clear();
+        for (uint32_t current = root; current != n; ) {
+            path.push_back(current);
+            current = precedes(n, current) ? nodes.left(current) : nodes.right(current);
+        }
+    }
+
+    uint32_t parentOnPath() const {
+        return path.empty() ? NIL : path.back();
+    }
+
+    // Point parent's link (or root) at replacement instead of child
+    void relink(uint32_t parent, uint32_t child, uint32_t replacement) {
+        if (!parent) {
+            root = replacement;
+        } else if (nodes.left(parent) == child) {
+            nodes.left(parent) = replacement;
+        } else {
+            nodes.right(parent) = replacement;
+        }
+    }
+
+    // Rotate child n above its parent p; grand is p's parent (NIL at the root)
+    void rotateUp(uint32_t n, uint32_t p, uint32_t grand) {
+        if (nodes.left(p) == n) {
+            nodes.left(p) = nodes.right(n);
+            nodes.right(n) = p;
+        } else {
+            nodes.right(p) = nodes.left(n);
+            nodes.left(n) = p;
+        }
+        relink(grand, p, n);
+        rotationCount++;
+    }
+
+    // Rotate n up while it outranks its parent (path holds its ancestors)
+    void siftUp(uint32_t n) {
+        while (!path.empty() && outranks(n, path.back())) {
+            uint32_t parent = path.back();
+            path.pop_back();
+            rotateUp(n, parent, parentOnPath());
+        }
+    }
+
+    // Rotate n down while a child outranks it (path holds its ancestors)
+    void siftDown(uint32_t n) {
+        while (true) {
+            uint32_t l = nodes.left(n), r = nodes.right(n);
+            uint32_t best = NIL;
+            if (l && outranks(l, n)) best = l;
+            if (r && outranks(r, n) && (!best || outranks(r, l))) best = r;
+            if (!best) break;
+
+            rotateUp(best, n, parentOnPath());
+            path.push_back(best);
+        }
+    }
+
+    // Classic stack-based Cartesian tree over nodes 1.. already in key
+    // order, duplicates removed - O(n)
+    void buildCartesian() {
+        vector<uint32_t> spine;
+        for (uint32_t n = 1; n < nodes.size(); n++) {
+            uint32_t last = NIL;
+            while (!spine.empty() && outranks(n, spine.back())) {
+                last = spine.back();
+                spine.pop_back();
+            }
+            nodes.left(n) = last;
+            nodes.right(n) = NIL;
+            if (!spine.empty()) nodes.right(spine.back()) = n;
+            spine.push_back(n);
+        }
+        root = spine.empty() ? NIL : spine.front();
+    }
+
+    // Turn the posts staged in nodes 1.. into the tree: sort by key, drop
+    // repeated IDs (the earliest copy wins), index, then build in O(n)
+    void buildFromStaged() {
+        nodes.sortByKey();
+
+        reserveIndex(nodes.size());
+        uint32_t kept = 1;
+        for (size_t n = 1; n < nodes.size(); n++) {
+            nodes.copy(kept, n);
+            size_t i = probe(nodes.id(kept));
+            if (slots[i]) continue; // Post IDs are unique - duplicates are ignored
+            slots[i] = kept++;
+        }
+        nodes.truncate(kept);
+        nodeCount = kept - 1;
+
+        buildCartesian();
+    }
+
+    static bool fitsTimestamp(long long timestamp) {
+        return timestamp >= 0 && timestamp <= (long long)UINT32_MAX;
+    }
+
+    // Result view of node n. The ID is unpacked onto viewIds, which the
+    // caller has reserved room in, so earlier views of the query stay valid.
+    PostView viewOf(uint32_t n) {
+        size_t offset = viewIds.size();
+        viewIds += PackedId::unpack(nodes.id(n));
+        return PostView{string_view(viewIds.data() + offset, viewIds.size() - offset), nodes.timestamp(n),
+                        nodes.score(n)};
+    }
+
+    long long getMemoryUsageMB() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024; // Convert KB to MB
+    }
+
+public:
+    BasicCompactTreap() : freeHead(NIL), root(NIL), nodeCount(0), rotationCount(0), mask(INITIAL_SLOTS - 1) {
+        nodes.reset();
+        slots.assign(INITIAL_SLOTS, NIL);
+    }
+
+    // Add a post - O(log n) expected. Returns false for a duplicate ID, an
+    // ID that does not pack (see PackedId) or a timestamp outside 32 bits.
+    bool addPost(const string& postId, long long timestamp, int score) {
+        uint64_t id = PackedId::pack(postId);
+        if (!id || !fitsTimestamp(timestamp) || findNode(id)) return false;
+        if (nodes.size() > UINT32_MAX - 1 && !freeHead) {
+            cerr << "ERROR: CompactTreap node limit reached (" << UINT32_MAX - 1 << " nodes)" << endl;
+            return false;
+        }
+
+        uint32_t n = allocate(id, (uint32_t)timestamp, score);
+        indexInsert(n);
+        nodeCount++;
+
+        // Attach as a leaf by key, remembering the path for the sift
+        path.clear();
+        uint32_t parent = NIL;
+        for (uint32_t current = root; current; ) {
+            parent = current;
+            path.push_back(current);
+            current = precedes(n, current) ? nodes.left(current) : nodes.right(current);
+        }
+        if (!parent) {
+            root = n;
+        } else if (precedes(n, parent)) {
+            nodes.left(parent) = n;
+        } else {
+            nodes.right(parent) = n;
+        }
+
+        siftUp(n);
+        return true;
+    }
+
+    // Delete a post - O(log n) expected
+    bool deletePost(const string& postId) {
+        uint32_t n = findNode(PackedId::pack(postId));
+        if (!n) return false;
+
+        findPath(n);
+        while (nodes.left(n) && nodes.right(n)) {
+            uint32_t up = outranks(nodes.left(n), nodes.right(n)) ? nodes.left(n) : nodes.right(n);
+            rotateUp(up, n, parentOnPath());
+            path.push_back(up);
+        }
+        relink(parentOnPath(), n, nodes.left(n) ? nodes.left(n) : nodes.right(n));
+
+        indexErase(nodes.id(n));
+        release(n);
+        nodeCount--;
+        return true;
+    }
+
+    // Change a post's score by delta and restore heap order - O(log n) expected
+    bool updateScore(const string& postId, int delta) {
+        uint32_t n = findNode(PackedId::pack(postId));
+        if (!n) return false;
+
+        findPath(n);
+        nodes.score(n) += delta;
+        if (delta > 0) {
+            siftUp(n);
+        } else if (delta < 0) {
+            siftDown(n);
+        }
+        return true;
+    }
+
+    void likePost(const string& postId) {
+        updateScore(postId, 1);
+    }
+
+    void printPostById(const string& postId) {
+        cout << "[COMPACT] ";
+        uint32_t n = findNode(PackedId::pack(postId));
+        if (n) {
+            cout << "Post Found: [" << PackedId::unpack(nodes.id(n)) << ": T=" << nodes.timestamp(n)
+                 << ", S=" << nodes.score(n) << "]" << endl;
+        } else {
+            cout << "Post ID " << postId << " not found in CompactTreap." << endl;
+        }
+    }
+
+    // Most popular post is the heap root - O(1). IDs are stored packed, so
+    // the view's postId points into a buffer of this treap that the next
+    // query overwrites.
+    optional<PostView> getMostPopular() {
+        if (!root) return nullopt;
+        viewIds.clear();
+        viewIds.reserve(PackedId::MAX_LENGTH);
+        return viewOf(root);
+    }
+
+    // k most recent posts, newest first, written to out (room for k) -
+    // O(log n + k). Returns how many were written; their IDs stay valid
+    // until the next query.
+    size_t getMostRecent(int k, PostView* out) {
+        size_t count = 0;
+        size_t wanted = min((size_t)max(k, 0), (size_t)nodeCount);
+        viewIds.clear();
+        viewIds.reserve(wanted * PackedId::MAX_LENGTH);
+
+        vector<uint32_t> pending;
+        for (uint32_t current = root; current; current = nodes.right(current)) {
+            pending.push_back(current);
+        }
+        while (!pending.empty() && count < wanted) {
+            uint32_t n = pending.back();
+            pending.pop_back();
+            out[count++] = viewOf(n);
+            for (uint32_t current = nodes.left(n); current; current = nodes.right(current)) {
+                pending.push_back(current);
+            }
+        }
+        return count;
+    }
+
+    // Replace the contents with posts in O(n) after an O(n log n) sort.
+    // Posts whose ID or timestamp do not fit the compact layout are skipped.
+    void buildFromSorted(vector<Post>&& posts) {
+        clear();
+        nodes.reserve(posts.size() + 1);
+        for (const Post& post : posts) {
+            uint64_t id = PackedId::pack(post.postId);
+            if (!id || !fitsTimestamp(post.timestamp)) continue;
+            nodes.push(id, (uint32_t)post.timestamp, post.score);
+        }
+        posts.clear();
+        buildFromStaged();
+    }
+
+    void clear() {
+        nodes.reset();
+        slots.assign(INITIAL_SLOTS, NIL);
+        mask = INITIAL_SLOTS - 1;
+        freeHead = root = NIL;
+        nodeCount = 0;
+    }
+
+    // Get tree height - iterative, O(n)
+    int getHeight() {
+        int height = 0;
+        vector<pair<uint32_t, int>> pending;
+        if (root) pending.push_back({root, 1});
+        while (!pending.empty()) {
+            auto [n, depth] = pending.back();
+            pending.pop_back();
+            height = max(height, depth);
+            if (nodes.left(n)) pending.push_back({nodes.left(n), depth + 1});
+            if (nodes.right(n)) pending.push_back({nodes.right(n), depth + 1});
+        }
+        return height;
+    }
+
+    long long getNodeCount() const {
+        return nodeCount;
+    }
+
+    long long getRotationCount() const {
+        return rotationCount;
+    }
+
+    // Process RSS plus the node array and ID index held by this treap
+    MemoryUsage getMemoryUsage() {
+        return MemoryUsage{getMemoryUsageMB(), nodes.reservedBytes(),
+                           (size_t)nodeCount * Layout::NODE_BYTES, slots.capacity() * sizeof(uint32_t)};
+    }
+
+    //////////////////////////////////////////////////////////
+    //////////////// Loading from Data set ///////////////////
+    //////////////////////////////////////////////////////////
+
+    // Load the whole CSV (id,timestamp,score) straight into compact nodes,
+    // then build once - no time limit, meant for the full dataset
+    void loadFromCSV(const string& filename) {
+        long long skipped = 0;
+        bool cleared = false;
+
+        cout << "[COMPACT] Starting CSV load from: " << filename << endl;
+
+        // The old contents go only once the file is open and rows arrive
+        LoadStats stats = PostLoader::readCSV(
+            filename, "[COMPACT]", numeric_limits<double>::infinity(),
+            [&](string_view postId, long long timestamp, int score) {
+                if (!cleared) {
+                    clear();
+                    cleared = true;
+                }
+                uint64_t id = PackedId::pack(postId);
+                if (!id || !fitsTimestamp(timestamp) || nodes.size() > UINT32_MAX - 1) {
+                    skipped++;
+                    return;
+                }
+                nodes.push(id, (uint32_t)timestamp, score);
+            });
+        if (!stats.opened) return;
+        if (!cleared) clear();
+
+        auto buildStart = chrono::high_resolution_clock::now();
+        buildFromStaged();
+
+        double totalTime =
+            stats.seconds + chrono::duration<double>(chrono::high_resolution_clock::now() - buildStart).count();
+        cout << "\n[COMPACT] Loaded " << nodeCount << " posts (" << skipped << " skipped) in " << fixed
+             << setprecision(3) << totalTime << "s | Memory: " << getMemoryUsageMB() << " MB | Height: "
+             << getHeight() << endl;
+    }
+};
+
+// Default: whole 24-byte nodes in one array
+using CompactTreap = BasicCompactTreap<PackedLayout>;
+
+// Struct-of-arrays storage for traversal-heavy workloads
+using SplitCompactTreap = BasicCompactTreap<SplitLayout>;
+
+#endif // COMPACT_TREAP_H
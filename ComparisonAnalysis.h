@@ -6,21 +6,20 @@
 #include <cmath>
 #include <fstream>
 #include <cstdlib>
+#include <thread>
 
 #include "BST.h"
 #include "Treap.h"
+#include "CompactTreap.h"
+#include "AVLTree.h"
+#include "BPlusTree.h"
+#include "BasicTreap.h"
 
 using namespace std;
 
 #ifndef ANALYSIS_H
 #define ANALYSIS_H
 
-struct Post {
-    string postId;
-    long long timestamp;
-    int score;
-};
-
 struct LoadingResults {
     long long bst_csv_posts;
     long long treap_csv_posts;
@@ -30,33 +29,43 @@ struct LoadingResults {
     int treap_csv_height;
     int bst_tgz_height;
     int treap_tgz_height;
+    long long avl_csv_posts;
+    long long avl_tgz_posts;
+    int avl_csv_height;
+    int avl_tgz_height;
+    long long bplus_csv_posts;
+    long long bplus_tgz_posts;
+    int bplus_csv_height;
+    int bplus_tgz_height;
     double total_time;
 };
 
 struct OperationMetrics {
-    double insertionTime_BST, insertionTime_Treap;
-    double deletionTime_BST, deletionTime_Treap;
-    double searchTime_BST, searchTime_Treap;
-    double likeTime_BST, likeTime_Treap;
-    double balancingFactor_BST, balancingFactor_Treap;
-    double queryTime_BST, queryTime_Treap;
-    int treeHeight_BST, treeHeight_Treap;
-    int rotations_Treap;
-    long long nodeCount_BST, nodeCount_Treap;
+    double insertionTime_BST, insertionTime_Treap, insertionTime_AVL, insertionTime_BPlus;
+    double deletionTime_BST, deletionTime_Treap, deletionTime_AVL, deletionTime_BPlus;
+    double searchTime_BST, searchTime_Treap, searchTime_AVL, searchTime_BPlus;
+    double likeTime_BST, likeTime_Treap, likeTime_AVL, likeTime_BPlus;
+    double balancingFactor_BST, balancingFactor_Treap, balancingFactor_AVL, balancingFactor_BPlus;
+    double queryTime_BST, queryTime_Treap, queryTime_AVL, queryTime_BPlus;
+    int treeHeight_BST, treeHeight_Treap, treeHeight_AVL, treeHeight_BPlus;
+    int rotations_Treap, rotations_AVL;
+    long long nodeCount_BST, nodeCount_Treap, nodeCount_AVL, nodeCount_BPlus;
 };
 
 class ComparisonAnalysis {
 private:
     BinarySearchTree bst_csv, bst_tgz, bst_test;
     Treap treap_csv, treap_tgz, treap_test;
+    AVLTree avl_csv, avl_tgz;
+    BPlusTree bplus_csv, bplus_tgz;
     LoadingResults results;
     OperationMetrics opMetrics;
     vector<Post> testDataSet;
     
 public:
     ComparisonAnalysis() {
-        results = {0, 0, 0, 0, 0, 0, 0, 0, 0.0};
-        opMetrics = {0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+        results = LoadingResults();
+        opMetrics = OperationMetrics();
     }
     
     void initializeTestData(int dataSize) {
@@ -97,38 +106,66 @@ public:
     /// Run loading comparison and return results
         
     LoadingResults runLoadingComparison(int timeLimitSeconds, const string& csv_path, const string& tgz_path) {
-        LoadingResults res = {0, 0, 0, 0, 0, 0, 0, 0, 0.0};
+        LoadingResults res = LoadingResults();
         
         auto overallStart = chrono::high_resolution_clock::now();
         
         // Load BST from CSV
-        cout << "[1/4] BST from CSV..." << endl;
+        cout << "[1/8] BST from CSV..." << endl;
         bst_csv.loadFromCSVWithTimeout(csv_path, timeLimitSeconds);
         res.bst_csv_posts = bst_csv.getNodeCount();
         res.bst_csv_height = bst_csv.getHeight();
         cout << "      Posts: " << res.bst_csv_posts << " | Height: " << res.bst_csv_height << endl;
         
         // Load Treap from CSV
-        cout << "[2/4] Treap from CSV..." << endl;
+        cout << "[2/8] Treap from CSV..." << endl;
         treap_csv.loadFromCSVWithTimeout(csv_path, timeLimitSeconds);
         res.treap_csv_posts = treap_csv.getNodeCount();
         res.treap_csv_height = treap_csv.getHeight();
         cout << "      Posts: " << res.treap_csv_posts << " | Height: " << res.treap_csv_height << endl;
         
+        // Load AVL from CSV
+        cout << "[3/8] AVL from CSV..." << endl;
+        avl_csv.loadFromCSVWithTimeout(csv_path, timeLimitSeconds);
+        res.avl_csv_posts = avl_csv.getNodeCount();
+        res.avl_csv_height = avl_csv.getHeight();
+        cout << "      Posts: " << res.avl_csv_posts << " | Height: " << res.avl_csv_height << endl;
+        
+        // Load B+ tree from CSV
+        cout << "[4/8] B+ Tree from CSV..." << endl;
+        bplus_csv.loadFromCSVWithTimeout(csv_path, timeLimitSeconds);
+        res.bplus_csv_posts = bplus_csv.getNodeCount();
+        res.bplus_csv_height = bplus_csv.getHeight();
+        cout << "      Posts: " << res.bplus_csv_posts << " | Height: " << res.bplus_csv_height << endl;
+        
         // Load BST from TGZ
-        cout << "[3/4] BST from TGZ..." << endl;
+        cout << "[5/8] BST from TGZ..." << endl;
         bst_tgz.loadFromTGZWithTimeout(tgz_path, timeLimitSeconds);
         res.bst_tgz_posts = bst_tgz.getNodeCount();
         res.bst_tgz_height = bst_tgz.getHeight();
         cout << "      Posts: " << res.bst_tgz_posts << " | Height: " << res.bst_tgz_height << endl;
         
         // Load Treap from TGZ
-        cout << "[4/4] Treap from TGZ..." << endl;
+        cout << "[6/8] Treap from TGZ..." << endl;
         treap_tgz.loadFromTGZWithTimeout(tgz_path, timeLimitSeconds);
         res.treap_tgz_posts = treap_tgz.getNodeCount();
         res.treap_tgz_height = treap_tgz.getHeight();
         cout << "      Posts: " << res.treap_tgz_posts << " | Height: " << res.treap_tgz_height << endl;
         
+        // Load AVL from TGZ
+        cout << "[7/8] AVL from TGZ..." << endl;
+        avl_tgz.loadFromTGZWithTimeout(tgz_path, timeLimitSeconds);
+        res.avl_tgz_posts = avl_tgz.getNodeCount();
+        res.avl_tgz_height = avl_tgz.getHeight();
+        cout << "      Posts: " << res.avl_tgz_posts << " | Height: " << res.avl_tgz_height << endl;
+        
+        // Load B+ tree from TGZ
+        cout << "[8/8] B+ Tree from TGZ..." << endl;
+        bplus_tgz.loadFromTGZWithTimeout(tgz_path, timeLimitSeconds);
+        res.bplus_tgz_posts = bplus_tgz.getNodeCount();
+        res.bplus_tgz_height = bplus_tgz.getHeight();
+        cout << "      Posts: " << res.bplus_tgz_posts << " | Height: " << res.bplus_tgz_height << endl;
+        
         auto overallEnd = chrono::high_resolution_clock::now();
         res.total_time = chrono::duration<double>(overallEnd - overallStart).count();
         
@@ -149,11 +186,23 @@ public:
         cout << "│   Treap    │  CSV   │ " << setw(12) << results.treap_csv_posts << " │ " << setw(11) << results.treap_csv_height << " │ " 
             << (results.treap_csv_posts > 0 ? "    ✅ Done     " : "    ❌ Failed   ") << " │" << endl;
         cout << "├────────────┼────────┼──────────────┼─────────────┼──────────────────┤" << endl;
+        cout << "│    AVL     │  CSV   │ " << setw(12) << results.avl_csv_posts << " │ " << setw(11) << results.avl_csv_height << " │ " 
+            << (results.avl_csv_posts > 0 ? "    ✅ Done     " : "    ❌ Failed   ") << " │" << endl;
+        cout << "├────────────┼────────┼──────────────┼─────────────┼──────────────────┤" << endl;
+        cout << "│    B+      │  CSV   │ " << setw(12) << results.bplus_csv_posts << " │ " << setw(11) << results.bplus_csv_height << " │ " 
+            << (results.bplus_csv_posts > 0 ? "    ✅ Done     " : "    ❌ Failed   ") << " │" << endl;
+        cout << "├────────────┼────────┼──────────────┼─────────────┼──────────────────┤" << endl;
         cout << "│    BST     │  TGZ   │ " << setw(12) << results.bst_tgz_posts << " │ " << setw(11) << results.bst_tgz_height << " │ " 
             << (results.bst_tgz_posts > 0 ? "    ✅ Done     " : "    ❌ Failed   ") << " │" << endl;
         cout << "├────────────┼────────┼──────────────┼─────────────┼──────────────────┤" << endl;
         cout << "│   Treap    │  TGZ   │ " << setw(12) << results.treap_tgz_posts << " │ " << setw(11) << results.treap_tgz_height << " │ " 
             << (results.treap_tgz_posts > 0 ? "    ✅ Done     " : "    ❌ Failed   ") << " │" << endl;
+        cout << "├────────────┼────────┼──────────────┼─────────────┼──────────────────┤" << endl;
+        cout << "│    AVL     │  TGZ   │ " << setw(12) << results.avl_tgz_posts << " │ " << setw(11) << results.avl_tgz_height << " │ " 
+            << (results.avl_tgz_posts > 0 ? "    ✅ Done     " : "    ❌ Failed   ") << " │" << endl;
+        cout << "├────────────┼────────┼──────────────┼─────────────┼──────────────────┤" << endl;
+        cout << "│    B+      │  TGZ   │ " << setw(12) << results.bplus_tgz_posts << " │ " << setw(11) << results.bplus_tgz_height << " │ " 
+            << (results.bplus_tgz_posts > 0 ? "    ✅ Done     " : "    ❌ Failed   ") << " │" << endl;
         cout << "├────────────┴────────┴──────────────┴─────────────┴──────────────────┤" << endl;
         cout << "│ Total Time: " << setw(50) << fixed << setprecision(3) << (to_string(results.total_time) + " seconds") << " │" << endl;
         cout << "└─────────────────────────────────────────────────────────────────────┘" << endl;
@@ -168,6 +217,14 @@ public:
         pythonCmd += " " + to_string(results.treap_csv_height);
         pythonCmd += " " + to_string(results.bst_tgz_height);
         pythonCmd += " " + to_string(results.treap_tgz_height);
+        pythonCmd += " " + to_string(results.avl_csv_posts);
+        pythonCmd += " " + to_string(results.avl_tgz_posts);
+        pythonCmd += " " + to_string(results.avl_csv_height);
+        pythonCmd += " " + to_string(results.avl_tgz_height);
+        pythonCmd += " " + to_string(results.bplus_csv_posts);
+        pythonCmd += " " + to_string(results.bplus_tgz_posts);
+        pythonCmd += " " + to_string(results.bplus_csv_height);
+        pythonCmd += " " + to_string(results.bplus_tgz_height);
 
         int graphStatus = system(pythonCmd.c_str());
         cout << "📊 File loading comparison graph closed." << endl;
@@ -184,30 +241,16 @@ public:
         cout << "Testing CSV Loading..." << endl;
         BinarySearchTree bst;
         Treap treap;
+        AVLTree avl;
+        BPlusTree bplus;
         
         double time_treap = treap.loadFromCSV(csv_path);
         double time_bst = bst.loadFromCSV(csv_path);  // Now this works!
+        double time_avl = avl.loadFromCSV(csv_path);
+        double time_bplus = bplus.loadFromCSV(csv_path);
 
-        cout << "┌───────────────────┬────────────┬────────────┬────────────┐" << endl;
-        cout << "│      Metric       │    BST     │   Treap    │   Winner   │" << endl;
-        cout << "├───────────────────┼────────────┼────────────┼────────────┤" << endl;
-        cout << "│ Loading Time (s)  │ " << setw(10) << fixed << setprecision(3) << time_bst 
-            << " │ " << setw(10) << time_treap << " │ ";
-        if (time_bst < time_treap) {
-            cout << "   BST    │" << endl;
-        } else {
-            cout << "  Treap    │" << endl;
-        }
-        cout << "├───────────────────┼────────────┼────────────┼────────────┤" << endl;
-        cout << "│ Tree Height       │ " << setw(10) << bst.getHeight() 
-            << " │ " << setw(10) << treap.getHeight() << " │ ";
-        if (bst.getHeight() < treap.getHeight()) {
-            cout << "   BST    │" << endl;
-        } else {
-            cout << "  Treap    │" << endl;
-        }
-        cout << "└───────────────────┴────────────┴────────────┴────────────┘" << endl;
-    
+        printLoadingTable(time_bst, time_treap, time_avl, time_bplus,
+                          bst.getHeight(), treap.getHeight(), avl.getHeight(), bplus.getHeight());
     
         string pythonCmd = "python3 scripts/plot_loading.py";
         pythonCmd += " CSV"; 
@@ -215,6 +258,10 @@ public:
         pythonCmd += " " + to_string(time_treap);
         pythonCmd += " " + to_string(bst.getHeight());
         pythonCmd += " " + to_string(treap.getHeight());
+        pythonCmd += " " + to_string(time_avl);
+        pythonCmd += " " + to_string(avl.getHeight());
+        pythonCmd += " " + to_string(time_bplus);
+        pythonCmd += " " + to_string(bplus.getHeight());
 
         int graphStatus = system(pythonCmd.c_str());
         cout << "📊 Loading performance graph closed." << endl;
@@ -226,29 +273,16 @@ public:
         cout << "Testing TGZ Loading..." << endl;
         BinarySearchTree bst;
         Treap treap;
+        AVLTree avl;
+        BPlusTree bplus;
         
         double time_treap = treap.loadFromTGZ(tgz_path);
         double time_bst = bst.loadFromTGZ(tgz_path);
+        double time_avl = avl.loadFromTGZ(tgz_path);
+        double time_bplus = bplus.loadFromTGZ(tgz_path);
 
-        cout << "┌───────────────────┬────────────┬────────────┬────────────┐" << endl;
-        cout << "│      Metric       │    BST     │   Treap    │   Winner   │" << endl;
-        cout << "├───────────────────┼────────────┼────────────┼────────────┤" << endl;
-        cout << "│ Loading Time (s)  │ " << setw(10) << fixed << setprecision(3) << time_bst 
-            << " │ " << setw(10) << time_treap << " │ ";
-        if (time_bst < time_treap) {
-            cout << "   BST    │" << endl;
-        } else {
-            cout << "  Treap    │" << endl;
-        }
-        cout << "├───────────────────┼────────────┼────────────┼────────────┤" << endl;
-        cout << "│ Tree Height       │ " << setw(10) << bst.getHeight() 
-            << " │ " << setw(10) << treap.getHeight() << " │ ";
-        if (bst.getHeight() < treap.getHeight()) {
-            cout << "   BST    │" << endl;
-        } else {
-            cout << "  Treap    │" << endl;
-        }
-        cout << "└───────────────────┴────────────┴────────────┴────────────┘" << endl;
+        printLoadingTable(time_bst, time_treap, time_avl, time_bplus,
+                          bst.getHeight(), treap.getHeight(), avl.getHeight(), bplus.getHeight());
 
         // Add graph
         string pythonCmd = "python3 scripts/plot_loading.py";
@@ -257,10 +291,87 @@ public:
         pythonCmd += " " + to_string(time_treap);
         pythonCmd += " " + to_string(bst.getHeight());
         pythonCmd += " " + to_string(treap.getHeight());
+        pythonCmd += " " + to_string(time_avl);
+        pythonCmd += " " + to_string(avl.getHeight());
+        pythonCmd += " " + to_string(time_bplus);
+        pythonCmd += " " + to_string(bplus.getHeight());
 
         int graphStatus = system(pythonCmd.c_str());
         cout << "📊 TGZ Loading performance graph closed." << endl;
     }
+
+    /// Parallel CSV loading (Treap, bulk built) on 1, 2, 4, ... threads up to all cores
+
+    void testParallelCSVLoading(const string& csv_path, int timeLimitSeconds) {
+        int cores = max(1, (int)thread::hardware_concurrency());
+        vector<int> threadCounts;
+        for (int threads = 1; threads < cores; threads *= 2) threadCounts.push_back(threads);
+        threadCounts.push_back(cores);
+
+        cout << "Testing parallel CSV loading on 1 to " << cores << " threads..." << endl;
+        vector<ParallelLoadStats> runs;
+        for (int threads : threadCounts) {
+            Treap treap;
+            runs.push_back(treap.loadFromCSVParallel(csv_path, threads, timeLimitSeconds));
+            if (!runs.back().opened) return;
+        }
+
+        // Throughput of the parallel part (parse + merge); the bulk build is serial
+        auto rateOf = [](const ParallelLoadStats& run) {
+            double seconds = run.parseSeconds + run.mergeSeconds;
+            return seconds > 0 ? run.posts / seconds : 0.0;
+        };
+        double baseRate = rateOf(runs[0]);
+
+        cout << "┌─────────┬──────────────┬────────────┬────────────┬────────────┬──────────────┬─────────┐" << endl;
+        cout << "│ Threads │    Posts     │ Parse (s)  │ Merge (s)  │ Build (s)  │   Posts/s    │ Speedup │" << endl;
+        cout << "├─────────┼──────────────┼────────────┼────────────┼────────────┼──────────────┼─────────┤" << endl;
+        for (const ParallelLoadStats& run : runs) {
+            double rate = rateOf(run);
+            cout << "│ " << setw(7) << run.threads << " │ " << setw(12) << run.posts
+                << " │ " << setw(10) << fixed << setprecision(3) << run.parseSeconds
+                << " │ " << setw(10) << run.mergeSeconds << " │ " << setw(10) << run.buildSeconds
+                << " │ " << setw(12) << setprecision(0) << rate
+                << " │ " << setw(6) << setprecision(2) << (baseRate > 0 ? rate / baseRate : 0.0) << "x │" << endl;
+        }
+        cout << "└─────────┴──────────────┴────────────┴────────────┴────────────┴──────────────┴─────────┘" << endl;
+        if (runs.back().timedOut) {
+            cout << "Runs that hit the " << timeLimitSeconds << "s limit loaded part of the file; compare Posts/s." << endl;
+        }
+
+        string pythonCmd = "python3 scripts/plot_csv_scaling.py";
+        for (const ParallelLoadStats& run : runs) {
+            pythonCmd += " " + to_string(run.threads);
+            pythonCmd += " " + to_string(run.posts);
+            pythonCmd += " " + to_string(run.parseSeconds);
+            pythonCmd += " " + to_string(run.mergeSeconds);
+            pythonCmd += " " + to_string(run.buildSeconds);
+        }
+
+        if (system(pythonCmd.c_str()) != 0) {
+            cerr << "Could not draw the scaling graph (needs python3 with matplotlib)" << endl;
+        } else {
+            cout << "📊 Parallel CSV loading graph closed." << endl;
+        }
+    }
+
+    /// Estimated full-load time and height for each structure (lower wins)
+
+    void printLoadingTable(double time_bst, double time_treap, double time_avl, double time_bplus,
+                           int height_bst, int height_treap, int height_avl, int height_bplus) {
+        cout << "┌───────────────────┬────────────┬────────────┬────────────┬────────────┬────────────┐" << endl;
+        cout << "│      Metric       │    BST     │   Treap    │    AVL     │     B+     │   Winner   │" << endl;
+        cout << "├───────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "│ Loading Time (s)  │ " << setw(10) << fixed << setprecision(3) << time_bst 
+            << " │ " << setw(10) << time_treap << " │ " << setw(10) << time_avl << " │ " << setw(10) << time_bplus << " │ "
+            << winnerLabel({{"BST", time_bst}, {"Treap", time_treap}, {"AVL", time_avl}, {"B+", time_bplus}}) << " │" << endl;
+        cout << "├───────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "│ Tree Height       │ " << setw(10) << height_bst 
+            << " │ " << setw(10) << height_treap << " │ " << setw(10) << height_avl << " │ " << setw(10) << height_bplus << " │ "
+            << winnerLabel({{"BST", (double)height_bst}, {"Treap", (double)height_treap}, {"AVL", (double)height_avl},
+                            {"B+", (double)height_bplus}}) << " │" << endl;
+        cout << "└───────────────────┴────────────┴────────────┴────────────┴────────────┴────────────┘" << endl;
+    }
     
 
     ///////////////////////////////////////////////////////
@@ -274,9 +385,9 @@ public:
         
         // Test with different dataset sizes
         vector<int> testSizes = {100, 1000, 5000, 10000};
-        vector<double> bstInsertTimes, treapInsertTimes;
-        vector<int> bstHeights, treapHeights;
-        vector<double> bstBalancingFactors, treapBalancingFactors;  // NEW
+        vector<double> bstInsertTimes, treapInsertTimes, randomTreapInsertTimes, avlInsertTimes, bplusInsertTimes;
+        vector<int> bstHeights, treapHeights, avlHeights, avlRotations, bplusHeights;
+        vector<double> bstBalancingFactors, treapBalancingFactors, avlBalancingFactors, bplusBalancingFactors;
 
         int lineCount = 0;
 
@@ -332,50 +443,164 @@ public:
             end = chrono::high_resolution_clock::now();
             double treap_time = chrono::duration<double, milli>(end - start).count();
             int treap_height = treap.getHeight();
-            int rotations = treap.getRotationCount();
+            lineCount = 0;
+
+            // Test Treap insertion with random priorities (shape independent of score)
+            Treap randomTreap(PriorityMode::Random);
+            start = chrono::high_resolution_clock::now();
+
+            for (const auto& post : testDataSet) {
+                randomTreap.addPost(post.postId, post.timestamp, post.score);
+            }
+
+            end = chrono::high_resolution_clock::now();
+            double random_treap_time = chrono::duration<double, milli>(end - start).count();
+            int random_treap_height = randomTreap.getHeight();
+
+            // Test AVL insertion (rebalances on every insert)
+            AVLTree avl;
+            start = chrono::high_resolution_clock::now();
+
+            for (const auto& post : testDataSet) {
+                avl.addPost(post.postId, post.timestamp, post.score);
+            }
+
+            end = chrono::high_resolution_clock::now();
+            double avl_time = chrono::duration<double, milli>(end - start).count();
+            int avl_height = avl.getHeight();
+
+            // Test B+ tree insertion (splits fat nodes instead of rotating)
+            BPlusTree bplus;
+            start = chrono::high_resolution_clock::now();
+
+            for (const auto& post : testDataSet) {
+                bplus.addPost(post.postId, post.timestamp, post.score);
+            }
+
+            end = chrono::high_resolution_clock::now();
+            double bplus_time = chrono::duration<double, milli>(end - start).count();
+            int bplus_height = bplus.getHeight();
+
             std::cout << std::endl;
-            std::cout << "┌───────────────────┬────────────┬────────────┬────────────┐" << std::endl;
-            std::cout << "│      Category     │    BST     │   Treap    │   Winner   │" << std::endl;
-            std::cout << "├───────────────────┼────────────┼────────────┼────────────┤" << std::endl;
+            std::cout << "┌───────────────────┬────────────┬────────────┬────────────┬────────────┬────────────┬────────────┐" << std::endl;
+            std::cout << "│      Category     │    BST     │   Treap    │ Treap(Rnd) │    AVL     │     B+     │   Winner   │" << std::endl;
+            std::cout << "├───────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << std::endl;
             std::cout << "│ Insertion Time(ms)│ " << std::setw(10) << fixed << setprecision(3) << bst_time 
-                      << " │ " << std::setw(10) << fixed << setprecision(3) << treap_time << " │ ";
-            if (bst_time < treap_time) {
-                std::cout << "   BST    │" << std::endl;
-            } else {
-                std::cout << "  Treap    │" << std::endl;
-            }
-            std::cout << "├───────────────────┼────────────┼────────────┼────────────┤" << std::endl;
+                      << " │ " << std::setw(10) << fixed << setprecision(3) << treap_time
+                      << " │ " << std::setw(10) << fixed << setprecision(3) << random_treap_time
+                      << " │ " << std::setw(10) << fixed << setprecision(3) << avl_time
+                      << " │ " << std::setw(10) << fixed << setprecision(3) << bplus_time << " │ "
+                      << winnerLabel({{"BST", bst_time}, {"Treap", treap_time}, {"Treap(Rnd)", random_treap_time},
+                                      {"AVL", avl_time}, {"B+", bplus_time}})
+                      << " │" << std::endl;
+            std::cout << "├───────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << std::endl;
             std::cout << "│   Tree Height     │ " << std::setw(10) << bst_height 
-                      << " │ " << std::setw(10) << treap_height << " │ ";
-            if (bst_height < treap_height) {
-                std::cout << "   BST    │" << std::endl;
-            } else {
-                std::cout << "  Treap    │" << std::endl;
-            }
-            std::cout << "├───────────────────┼────────────┼────────────┼────────────┤" << std::endl;
-            std::cout << "│   Rotations       │     N/A    │ " << std::setw(10) << treap.getRotationCount() << " │   Treap    │" << std::endl;
-            std::cout << "└───────────────────┴────────────┴────────────┴────────────┘" << std::endl;
+                      << " │ " << std::setw(10) << treap_height
+                      << " │ " << std::setw(10) << random_treap_height
+                      << " │ " << std::setw(10) << avl_height
+                      << " │ " << std::setw(10) << bplus_height << " │ "
+                      << winnerLabel({{"BST", (double)bst_height}, {"Treap", (double)treap_height},
+                                      {"Treap(Rnd)", (double)random_treap_height}, {"AVL", (double)avl_height},
+                                      {"B+", (double)bplus_height}})
+                      << " │" << std::endl;
+            std::cout << "├───────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << std::endl;
+            std::cout << "│ Rotations/Splits  │     N/A    │ " << std::setw(10) << treap.getRotationCount()
+                      << " │ " << std::setw(10) << randomTreap.getRotationCount()
+                      << " │ " << std::setw(10) << avl.getRotationCount()
+                      << " │ " << std::setw(10) << bplus.getSplitCount() << " │            │" << std::endl;
+            std::cout << "└───────────────────┴────────────┴────────────┴────────────┴────────────┴────────────┴────────────┘" << std::endl;
 
             bstInsertTimes.push_back(bst_time);
             treapInsertTimes.push_back(treap_time);
+            randomTreapInsertTimes.push_back(random_treap_time);
+            avlInsertTimes.push_back(avl_time);
+            bplusInsertTimes.push_back(bplus_time);
 
             bstHeights.push_back(bst.getHeight());
             treapHeights.push_back(treap.getHeight());
+            avlHeights.push_back(avl_height);
+            bplusHeights.push_back(bplus_height);
         
             double bstBalance = (double)bst.calculateMinHeight() / bst.getHeight();
             double treapBalance = (double)treap.calculateMinHeight() / treap.getHeight();
+            double avlBalance = (double)avl.calculateMinHeight() / avl_height;
             bstBalancingFactors.push_back(bstBalance);
             treapBalancingFactors.push_back(treapBalance);
+            avlBalancingFactors.push_back(avlBalance);
+            bplusBalancingFactors.push_back((double)bplus.calculateMinHeight() / bplus_height);
+            avlRotations.push_back(avl.getRotationCount());
+        }
+
+        // Per-post footprint of the largest run: pointer nodes vs compact nodes
+        Treap footprintTreap;
+        CompactTreap compactTreap;
+        for (const auto& post : testDataSet) {
+            footprintTreap.addPost(post.postId, post.timestamp, post.score);
+            compactTreap.addPost(post.postId, post.timestamp, post.score);
+        }
+        MemoryUsage treapMemory = footprintTreap.getMemoryUsage();
+        MemoryUsage compactMemory = compactTreap.getMemoryUsage();
+        double treapBytes = (double)(treapMemory.liveNodeBytes + treapMemory.indexBytes) / footprintTreap.getNodeCount();
+        double compactBytes = (double)(compactMemory.liveNodeBytes + compactMemory.indexBytes) / compactTreap.getNodeCount();
+        cout << "\nMemory per post (nodes + ID index): Treap " << fixed << setprecision(1) << treapBytes
+             << " B | CompactTreap " << compactBytes << " B | Height " << compactTreap.getHeight() << endl;
+
+        // Same compact treap with struct-of-arrays storage: the height walk
+        // reads only the child links
+        SplitCompactTreap splitTreap;
+        for (const auto& post : testDataSet) {
+            splitTreap.addPost(post.postId, post.timestamp, post.score);
+        }
+        auto start = chrono::high_resolution_clock::now();
+        int packedHeight = compactTreap.getHeight();
+        auto end = chrono::high_resolution_clock::now();
+        double packedWalk = chrono::duration<double, micro>(end - start).count();
+
+        start = chrono::high_resolution_clock::now();
+        int splitHeight = splitTreap.getHeight();
+        end = chrono::high_resolution_clock::now();
+        double splitWalk = chrono::duration<double, micro>(end - start).count();
+        cout << "Height walk: packed nodes " << fixed << setprecision(1) << packedWalk << " μs (height " << packedHeight
+             << ") | split arrays " << splitWalk << " μs (height " << splitHeight << ")" << endl;
+
+        // Bare engine instantiations over the same posts: unused policies
+        // should cost nothing over the plain random treap
+        BasicTreap<Post> plainTreap;
+        BasicTreap<Post, ValuePriority<PostScore>, less<PostKey>, UniqueKeys,
+                   Augments<SubtreeSize, SubtreeTop<PostScore>>> augmentedTreap;
+
+        start = chrono::high_resolution_clock::now();
+        for (const auto& post : testDataSet) {
+            plainTreap.emplace(post);
+        }
+        end = chrono::high_resolution_clock::now();
+        double plainInsert = chrono::duration<double, milli>(end - start).count();
+
+        start = chrono::high_resolution_clock::now();
+        for (const auto& post : testDataSet) {
+            augmentedTreap.emplace(post);
         }
+        end = chrono::high_resolution_clock::now();
+        double augmentedInsert = chrono::duration<double, milli>(end - start).count();
+        cout << "BasicTreap insert: random priority " << fixed << setprecision(3) << plainInsert << " ms (height "
+             << plainTreap.getHeight() << ") | score priority + size/top " << augmentedInsert << " ms (height "
+             << augmentedTreap.getHeight() << ")" << endl;
 
         opMetrics.insertionTime_BST = calculateAverage(bstInsertTimes);
         opMetrics.insertionTime_Treap = calculateAverage(treapInsertTimes);
+        opMetrics.insertionTime_AVL = calculateAverage(avlInsertTimes);
+        opMetrics.insertionTime_BPlus = calculateAverage(bplusInsertTimes);
 
         opMetrics.treeHeight_BST = calculateAverage(bstHeights);
         opMetrics.treeHeight_Treap = calculateAverage(treapHeights);
+        opMetrics.treeHeight_AVL = calculateAverage(avlHeights);
+        opMetrics.treeHeight_BPlus = calculateAverage(bplusHeights);
 
         opMetrics.balancingFactor_BST = calculateAverage(bstBalancingFactors);
         opMetrics.balancingFactor_Treap = calculateAverage(treapBalancingFactors);
+        opMetrics.balancingFactor_AVL = calculateAverage(avlBalancingFactors);
+        opMetrics.balancingFactor_BPlus = calculateAverage(bplusBalancingFactors);
+        opMetrics.rotations_AVL = calculateAverage(avlRotations);
 
         /// Graphs
 
@@ -384,6 +609,9 @@ public:
         for (int size : testSizes) pythonCmd += " " + to_string(size);
         for (double time : bstInsertTimes) pythonCmd += " " + to_string(time);
         for (double time : treapInsertTimes) pythonCmd += " " + to_string(time);
+        for (double time : randomTreapInsertTimes) pythonCmd += " " + to_string(time);
+        for (double time : avlInsertTimes) pythonCmd += " " + to_string(time);
+        for (double time : bplusInsertTimes) pythonCmd += " " + to_string(time);
         
         // Run Python in background
         int temp = system((pythonCmd).c_str());
@@ -403,9 +631,11 @@ public:
         // Use a medium-sized dataset
         initializeTestData(5000);
         
-        // Build both trees first
+        // Build every tree first
         BinarySearchTree bst;
         Treap treap;
+        AVLTree avl;
+        BPlusTree bplus;
         
         cout << "Building trees for search tests..." << endl;
         int lineCount = 0;
@@ -440,89 +670,246 @@ public:
             }
         }
         cout << endl;
+
+        // Build AVL and B+ tree
+        for (const auto& post : testDataSet) {
+            avl.addPost(post.postId, post.timestamp, post.score);
+            bplus.addPost(post.postId, post.timestamp, post.score);
+        }
         
-        cout << "Trees built - BST Height: " << bst.getHeight() << " | Treap Height: " << treap.getHeight() << endl;
+        cout << "Trees built - BST Height: " << bst.getHeight() << " | Treap Height: " << treap.getHeight()
+             << " | AVL Height: " << avl.getHeight() << " | B+ Height: " << bplus.getHeight() << endl;
         
+        // Result buffer shared by the list queries below
+        PostView recent[10];
+
         // Test 1: getMostPopular() performance
         cout << "\n--- getMostPopular() Test (1000 iterations) ---" << endl;
         
         start = chrono::high_resolution_clock::now();
         for (int i = 0; i < 1000; i++) {
-            bst.getMostPopular();
+            keep(bst.getMostPopular());
         }
         auto end = chrono::high_resolution_clock::now();
         double bst_most_popular = chrono::duration<double, micro>(end - start).count() / 1000.0;
         
         start = chrono::high_resolution_clock::now();
         for (int i = 0; i < 1000; i++) {
-            treap.getMostPopular();
+            keep(treap.getMostPopular());
         }
         end = chrono::high_resolution_clock::now();
         double treap_most_popular = chrono::duration<double, micro>(end - start).count() / 1000.0;
         
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 1000; i++) {
+            keep(avl.getMostPopular());
+        }
+        end = chrono::high_resolution_clock::now();
+        double avl_most_popular = chrono::duration<double, micro>(end - start).count() / 1000.0;
+
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 1000; i++) {
+            keep(bplus.getMostPopular());
+        }
+        end = chrono::high_resolution_clock::now();
+        double bplus_most_popular = chrono::duration<double, micro>(end - start).count() / 1000.0;
+        
         // Test 2: getMostRecent(k) performance
         cout << "\n--- getMostRecent(10) Test (100 iterations) ---" << endl;
         
         start = chrono::high_resolution_clock::now();
         for (int i = 0; i < 100; i++) {
-            bst.getMostRecent(10);
+            keep(bst.getMostRecent(10, recent));
         }
         end = chrono::high_resolution_clock::now();
         double bst_most_recent = chrono::duration<double, micro>(end - start).count() / 100.0;
         
         start = chrono::high_resolution_clock::now();
         for (int i = 0; i < 100; i++) {
-            treap.getMostRecent(10);
+            keep(treap.getMostRecent(10, recent));
         }
         end = chrono::high_resolution_clock::now();
         double treap_most_recent = chrono::duration<double, micro>(end - start).count() / 100.0;
         
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 100; i++) {
+            keep(avl.getMostRecent(10, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double avl_most_recent = chrono::duration<double, micro>(end - start).count() / 100.0;
+
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 100; i++) {
+            keep(bplus.getMostRecent(10, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double bplus_most_recent = chrono::duration<double, micro>(end - start).count() / 100.0;
+        
         // Display results in table format
-        cout << "\n┌──────────────────────────┬────────────┬────────────┬────────────┐" << endl;
-        cout << "│        Category          │    BST     │   Treap    │   Winner   │" << endl;
-        cout << "├──────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "\n┌──────────────────────────┬────────────┬────────────┬────────────┬────────────┬────────────┐" << endl;
+        cout << "│        Category          │    BST     │   Treap    │    AVL     │     B+     │   Winner   │" << endl;
+        cout << "├──────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         
         // getMostPopular row
         cout << "│  getMostPopular (μs)     │ " << setw(10) << fixed << setprecision(3) << bst_most_popular 
-            << " │ " << setw(10) << fixed << setprecision(3) << treap_most_popular << " │ ";
-        if (bst_most_popular < treap_most_popular) {
-            cout << "   BST    │" << endl;
-        } else {
-            cout << "  Treap    │" << endl;
-        }
+            << " │ " << setw(10) << treap_most_popular << " │ " << setw(10) << avl_most_popular
+            << " │ " << setw(10) << bplus_most_popular << " │ "
+            << winnerLabel({{"BST", bst_most_popular}, {"Treap", treap_most_popular}, {"AVL", avl_most_popular},
+                            {"B+", bplus_most_popular}}) << " │" << endl;
         
         // getMostRecent row
-        cout << "├──────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "├──────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         cout << "│ getMostRecent(10) (μs)   │ " << setw(10) << fixed << setprecision(3) << bst_most_recent 
-            << " │ " << setw(10) << fixed << setprecision(3) << treap_most_recent << " │ ";
-        if (bst_most_recent < treap_most_recent) {
-            cout << "   BST    │" << endl;
-        } else {
-            cout << "  Treap    │" << endl;
-        }
+            << " │ " << setw(10) << treap_most_recent << " │ " << setw(10) << avl_most_recent
+            << " │ " << setw(10) << bplus_most_recent << " │ "
+            << winnerLabel({{"BST", bst_most_recent}, {"Treap", treap_most_recent}, {"AVL", avl_most_recent},
+                            {"B+", bplus_most_recent}}) << " │" << endl;
         
-        // Speed multiplier row
-        cout << "├──────────────────────────┼────────────┼────────────┼────────────┤" << endl;
-        double popular_speedup = bst_most_popular / treap_most_popular;
-        double recent_speedup = bst_most_recent / treap_most_recent;
+        // Speed multiplier row: how many times faster than the BST
+        cout << "├──────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        double treap_speedup = (bst_most_popular + bst_most_recent) / (treap_most_popular + treap_most_recent);
+        double avl_speedup = (bst_most_popular + bst_most_recent) / (avl_most_popular + avl_most_recent);
+        double bplus_speedup = (bst_most_popular + bst_most_recent) / (bplus_most_popular + bplus_most_recent);
         
-        cout << "│ Popular Speed Multiplier │" << setw(10) << fixed << setprecision(1) << popular_speedup 
-            << "x │ " << setw(9) << fixed << setprecision(1) << recent_speedup << "x │ ";
+        cout << "│ Speed Multiplier vs BST  │       1.0x │ " << setw(9) << fixed << setprecision(1) << treap_speedup
+            << "x │ " << setw(9) << avl_speedup << "x │ " << setw(9) << bplus_speedup << "x │ "
+            << winnerLabel({{"BST", 1.0}, {"Treap", 1.0 / treap_speedup}, {"AVL", 1.0 / avl_speedup},
+                            {"B+", 1.0 / bplus_speedup}}) << " │" << endl;
         
-        if (popular_speedup > 1.0 || recent_speedup > 1.0) {
-            cout << "  Treap    │" << endl;
-        } else {
-            cout << "   BST    │" << endl;
+        cout << "└──────────────────────────┴────────────┴────────────┴────────────┴────────────┴────────────┘" << endl;
+
+        // Test 3: frozen (pointer-free, Eytzinger-ordered) snapshots against
+        // the pointer trees they were taken from
+        cout << "\n--- Frozen Snapshot Test (1000 lookups / range counts) ---" << endl;
+
+        start = chrono::high_resolution_clock::now();
+        FrozenSnapshot bst_frozen = bst.freeze();
+        end = chrono::high_resolution_clock::now();
+        double bst_freeze_ms = chrono::duration<double, milli>(end - start).count();
+
+        start = chrono::high_resolution_clock::now();
+        FrozenSnapshot treap_frozen = treap.freeze();
+        end = chrono::high_resolution_clock::now();
+        double treap_freeze_ms = chrono::duration<double, milli>(end - start).count();
+
+        cout << "Frozen in " << fixed << setprecision(3) << bst_freeze_ms << " ms (BST) / " << treap_freeze_ms
+             << " ms (Treap) | Snapshot size: " << treap_frozen.memoryBytes() / 1024 << " KB" << endl;
+
+        // Same probe keys and windows for every structure
+        vector<const Post*> probes;
+        vector<pair<long long, long long>> windows;
+        for (int i = 0; i < 1000; i++) {
+            const Post& post = testDataSet[rand() % testDataSet.size()];
+            probes.push_back(&post);
+            windows.push_back({post.timestamp, post.timestamp + 86400});
         }
-        
-        cout << "└──────────────────────────┴────────────┴────────────┴────────────┘" << endl;
+
+        // Point lookups by (timestamp, postId)
+        long long found = 0;
+        start = chrono::high_resolution_clock::now();
+        for (const Post* post : probes) found += bst.find(post->timestamp, post->postId) != nullptr;
+        end = chrono::high_resolution_clock::now();
+        double bst_lookup = chrono::duration<double, micro>(end - start).count() / probes.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (const Post* post : probes) found += bst_frozen.contains(post->timestamp, post->postId);
+        end = chrono::high_resolution_clock::now();
+        double bst_frozen_lookup = chrono::duration<double, micro>(end - start).count() / probes.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (const Post* post : probes) found += treap.find(post->timestamp, post->postId) != nullptr;
+        end = chrono::high_resolution_clock::now();
+        double treap_lookup = chrono::duration<double, micro>(end - start).count() / probes.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (const Post* post : probes) found += treap_frozen.contains(post->timestamp, post->postId);
+        end = chrono::high_resolution_clock::now();
+        double treap_frozen_lookup = chrono::duration<double, micro>(end - start).count() / probes.size();
+
+        // Range counts over one-day windows
+        long long counted = 0;
+        start = chrono::high_resolution_clock::now();
+        for (const auto& window : windows) counted += bst.countInRange(window.first, window.second);
+        end = chrono::high_resolution_clock::now();
+        double bst_range = chrono::duration<double, micro>(end - start).count() / windows.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (const auto& window : windows) counted += bst_frozen.countInRange(window.first, window.second);
+        end = chrono::high_resolution_clock::now();
+        double bst_frozen_range = chrono::duration<double, micro>(end - start).count() / windows.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (const auto& window : windows) counted += treap.countInRange(window.first, window.second);
+        end = chrono::high_resolution_clock::now();
+        double treap_range = chrono::duration<double, micro>(end - start).count() / windows.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (const auto& window : windows) counted += treap_frozen.countInRange(window.first, window.second);
+        end = chrono::high_resolution_clock::now();
+        double treap_frozen_range = chrono::duration<double, micro>(end - start).count() / windows.size();
+
+        // getMostPopular / getMostRecent served from the snapshots
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 1000; i++) {
+            keep(bst_frozen.getMostPopular());
+        }
+        end = chrono::high_resolution_clock::now();
+        double bst_frozen_popular = chrono::duration<double, micro>(end - start).count() / 1000.0;
+
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 1000; i++) {
+            keep(treap_frozen.getMostPopular());
+        }
+        end = chrono::high_resolution_clock::now();
+        double treap_frozen_popular = chrono::duration<double, micro>(end - start).count() / 1000.0;
+
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 100; i++) {
+            keep(bst_frozen.getMostRecent(10, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double bst_frozen_recent = chrono::duration<double, micro>(end - start).count() / 100.0;
+
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 100; i++) {
+            keep(treap_frozen.getMostRecent(10, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double treap_frozen_recent = chrono::duration<double, micro>(end - start).count() / 100.0;
+
+        cout << "Lookups found: " << found << "/" << 4 * probes.size() << " | Posts counted: " << counted << endl;
+
+        auto frozenRow = [&](const string& label, double bst_time, double bst_frozen_time,
+                             double treap_time, double treap_frozen_time) {
+            cout << "│ " << label << " │ " << setw(10) << fixed << setprecision(3) << bst_time
+                 << " │ " << setw(10) << bst_frozen_time << " │ " << setw(10) << treap_time
+                 << " │ " << setw(10) << treap_frozen_time << " │ "
+                 << winnerLabel({{"BST", bst_time}, {"BST(Frz)", bst_frozen_time}, {"Treap", treap_time},
+                                 {"Treap(Frz)", treap_frozen_time}}) << " │" << endl;
+        };
+
+        cout << "\n┌──────────────────────────┬────────────┬────────────┬────────────┬────────────┬────────────┐" << endl;
+        cout << "│        Category          │    BST     │  BST(Frz)  │   Treap    │ Treap(Frz) │   Winner   │" << endl;
+        cout << "├──────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        frozenRow("Key lookup (μs)         ", bst_lookup, bst_frozen_lookup, treap_lookup, treap_frozen_lookup);
+        cout << "├──────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        frozenRow("countInRange (μs)       ", bst_range, bst_frozen_range, treap_range, treap_frozen_range);
+        cout << "├──────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        frozenRow("getMostPopular (μs)     ", bst_most_popular, bst_frozen_popular, treap_most_popular, treap_frozen_popular);
+        cout << "├──────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        frozenRow("getMostRecent(10) (μs)  ", bst_most_recent, bst_frozen_recent, treap_most_recent, treap_frozen_recent);
+        cout << "└──────────────────────────┴────────────┴────────────┴────────────┴────────────┴────────────┘" << endl;
 
         double avg_bst_search = (bst_most_popular + bst_most_recent) / 2.0;
         double avg_treap_search = (treap_most_popular + treap_most_recent) / 2.0;
+        double avg_avl_search = (avl_most_popular + avl_most_recent) / 2.0;
+        double avg_bplus_search = (bplus_most_popular + bplus_most_recent) / 2.0;
 
         // Store in your metrics struct
         opMetrics.searchTime_BST = avg_bst_search;
         opMetrics.searchTime_Treap = avg_treap_search;
+        opMetrics.searchTime_AVL = avg_avl_search;
+        opMetrics.searchTime_BPlus = avg_bplus_search;
 
         // Graph for search performance
         string pythonCmd = "python3 scripts/plot_search.py";
@@ -530,6 +917,12 @@ public:
         pythonCmd += " " + to_string(bst_most_recent);
         pythonCmd += " " + to_string(treap_most_popular);
         pythonCmd += " " + to_string(treap_most_recent);
+        pythonCmd += " " + to_string(avl_most_popular);
+        pythonCmd += " " + to_string(avl_most_recent);
+        pythonCmd += " " + to_string(bplus_most_popular);
+        pythonCmd += " " + to_string(bplus_most_recent);
+        pythonCmd += " " + to_string(treap_frozen_popular);
+        pythonCmd += " " + to_string(treap_frozen_recent);
 
         int temp = system(pythonCmd.c_str());
         cout << "📊 Search performance graph closed. Continuing..." << endl;
@@ -548,9 +941,11 @@ public:
         // Use a medium-sized dataset
         initializeTestData(5000);
         
-        // Build both trees first
+        // Build every tree first
         BinarySearchTree bst;
         Treap treap;
+        AVLTree avl;
+        BPlusTree bplus;
         
         cout << "Building trees for like operation tests..." << endl;
         int lineCount = 0;
@@ -587,11 +982,19 @@ public:
             }
         }
         cout << endl;
+
+        // Build AVL and B+ tree
+        for (const auto& post : testDataSet) {
+            avl.addPost(post.postId, post.timestamp, post.score);
+            bplus.addPost(post.postId, post.timestamp, post.score);
+        }
         
-        cout << "Trees built - BST Height: " << bst.getHeight() << " | Treap Height: " << treap.getHeight() << endl;
+        cout << "Trees built - BST Height: " << bst.getHeight() << " | Treap Height: " << treap.getHeight()
+             << " | AVL Height: " << avl.getHeight() << " | B+ Height: " << bplus.getHeight() << endl;
         
-        // Reset rotation counter for Treap
+        // Reset rotation counters
         treap.resetRotationCount();
+        avl.resetRotationCount();
         
         // Test 1: Single like operation performance
         cout << "\n--- Single Like Operation Test (1000 iterations) ---" << endl;
@@ -613,6 +1016,22 @@ public:
         double treap_like_time = chrono::duration<double, micro>(end - start).count() / 1000.0;
         int total_rotations = treap.getRotationCount();
         
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 1000; i++) {
+            int randomIndex = rand() % testDataSet.size();
+            avl.likePost(testDataSet[randomIndex].postId);
+        }
+        end = chrono::high_resolution_clock::now();
+        double avl_like_time = chrono::duration<double, micro>(end - start).count() / 1000.0;
+
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 1000; i++) {
+            int randomIndex = rand() % testDataSet.size();
+            bplus.likePost(testDataSet[randomIndex].postId);
+        }
+        end = chrono::high_resolution_clock::now();
+        double bplus_like_time = chrono::duration<double, micro>(end - start).count() / 1000.0;
+        
         // Test 2: Multiple likes on same post (bubbling test)
         cout << "\n--- Multiple Likes Bubbling Test ---" << endl;
         
@@ -636,53 +1055,66 @@ public:
         end = chrono::high_resolution_clock::now();
         double bst_update_time = chrono::duration<double, micro>(end - start).count() / 100.0;
         
+        // AVL keys on (timestamp, postId), so a like only refreshes the max-score path
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 100; i++) {
+            avl.likePost(testPostId);
+        }
+        end = chrono::high_resolution_clock::now();
+        double avl_update_time = chrono::duration<double, micro>(end - start).count() / 100.0;
+        int avl_rotations = avl.getRotationCount();
+
+        // B+ tree likes only sift the popularity heap; the leaves never move
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 100; i++) {
+            bplus.likePost(testPostId);
+        }
+        end = chrono::high_resolution_clock::now();
+        double bplus_update_time = chrono::duration<double, micro>(end - start).count() / 100.0;
+        
         // Display results in table format
-        cout << "\n┌─────────────────────────────┬────────────┬────────────┬────────────┐" << endl;
-        cout << "│          Category           │    BST     │   Treap    │   Winner   │" << endl;
-        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "\n┌─────────────────────────────┬────────────┬────────────┬────────────┬────────────┬────────────┐" << endl;
+        cout << "│          Category           │    BST     │   Treap    │    AVL     │     B+     │   Winner   │" << endl;
+        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         
         // Single like row
         cout << "│  Single Like Time (μs)      │ " << setw(10) << fixed << setprecision(3) << bst_like_time 
-            << " │ " << setw(10) << fixed << setprecision(3) << treap_like_time << " │ ";
-        if (bst_like_time < treap_like_time) {
-            cout << "   BST     │" << endl;
-        } else {
-            cout << "  Treap   │" << endl;
-        }
+            << " │ " << setw(10) << treap_like_time << " │ " << setw(10) << avl_like_time
+            << " │ " << setw(10) << bplus_like_time << " │ "
+            << winnerLabel({{"BST", bst_like_time}, {"Treap", treap_like_time}, {"AVL", avl_like_time},
+                            {"B+", bplus_like_time}}) << " │" << endl;
         
         // Multiple likes row
-        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         cout << "│  Multiple Likes Time (μs)   │ " << setw(10) << fixed << setprecision(3) << bst_update_time 
-            << " │ " << setw(10) << fixed << setprecision(3) << treap_bubble_time << " │ ";
-        if (bst_update_time < treap_bubble_time) {
-            cout << "   BST     │" << endl;
-        } else {
-            cout << "  Treap   │" << endl;
-        }
+            << " │ " << setw(10) << treap_bubble_time << " │ " << setw(10) << avl_update_time
+            << " │ " << setw(10) << bplus_update_time << " │ "
+            << winnerLabel({{"BST", bst_update_time}, {"Treap", treap_bubble_time}, {"AVL", avl_update_time},
+                            {"B+", bplus_update_time}}) << " │" << endl;
         
         // Rotations row
-        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         cout << "│  Total Rotations            │     N/A    │ " << setw(10) << total_rotations 
-            << " │   Treap    │" << endl;
+            << " │ " << setw(10) << avl_rotations << " │     N/A    │            │" << endl;
         
         // Bubble rotations row
-        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         cout << "│  Bubble Rotations           │     N/A    │ " << setw(10) << bubble_rotations 
-            << " │   Treap    │" << endl;
+            << " │     N/A    │     N/A    │   Treap    │" << endl;
         
         // Speed multiplier row
-        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         double like_speedup = bst_like_time / treap_like_time;
         double bubble_speedup = bst_update_time / treap_bubble_time;
         cout << "│  Like Speed Multiplier      │ " << setw(9) << fixed << setprecision(1) << like_speedup 
-            << "x │ " << setw(9) << fixed << setprecision(1) << bubble_speedup << "x │ ";
+            << "x │ " << setw(9) << fixed << setprecision(1) << bubble_speedup << "x │            │            │ ";
         if (like_speedup > 1.0 || bubble_speedup > 1.0) {
-            cout << "  Treap   │" << endl;
+            cout << "  Treap    │" << endl;
         } else {
             cout << "   BST     │" << endl;
         }
         
-        cout << "└─────────────────────────────┴────────────┴────────────┴────────────┘" << endl;
+        cout << "└─────────────────────────────┴────────────┴────────────┴────────────┴────────────┴────────────┘" << endl;
         
         // Summary
         cout << "\n=== LIKE OPERATION SUMMARY ===" << endl;
@@ -695,10 +1127,16 @@ public:
         
         cout << "✅ Treap performed " << total_rotations << " total rotations to maintain heap property" << endl;
         cout << "✅ During bubbling test, Treap performed " << bubble_rotations << " rotations" << endl;
+        cout << "✅ AVL performed " << avl_rotations << " rotations - likes never change its shape" << endl;
+
+        opMetrics.likeTime_BST = bst_like_time;
+        opMetrics.likeTime_Treap = treap_like_time;
+        opMetrics.likeTime_AVL = avl_like_time;
+        opMetrics.likeTime_BPlus = bplus_like_time;
         
         // Check if bubbling actually worked
-        string most_popular_after = treap.getMostPopular();
-        if (most_popular_after.find(testPostId) != string::npos) {
+        optional<PostView> most_popular_after = treap.getMostPopular();
+        if (most_popular_after && most_popular_after->postId == testPostId) {
             cout << "✅ Bubbling verified - test post became most popular!" << endl;
         }
     
@@ -709,6 +1147,10 @@ public:
         pythonCmd += " " + to_string(treap_bubble_time);
         pythonCmd += " " + to_string(total_rotations);
         pythonCmd += " " + to_string(bubble_rotations);
+        pythonCmd += " " + to_string(avl_like_time);
+        pythonCmd += " " + to_string(avl_update_time);
+        pythonCmd += " " + to_string(bplus_like_time);
+        pythonCmd += " " + to_string(bplus_update_time);
 
         int graphStatus = system(pythonCmd.c_str());
         cout << "📊 Like operations graph closed. Continuing..." << endl;
@@ -727,11 +1169,11 @@ public:
         // Test with different dataset sizes
         vector<int> testSizes = {1000, 5000};
         
-        vector<int> bstInitialHeights, treapInitialHeights;
-        vector<int> bstFinalHeights, treapFinalHeights;
-        vector<int> deletionRotations;
+        vector<int> bstInitialHeights, treapInitialHeights, avlInitialHeights, bplusInitialHeights;
+        vector<int> bstFinalHeights, treapFinalHeights, avlFinalHeights, bplusFinalHeights;
+        vector<int> deletionRotations, avlDeletionRotations;
 
-        vector<double> bstDeletionTimes, treapDeletionTimes;
+        vector<double> bstDeletionTimes, treapDeletionTimes, avlDeletionTimes, bplusDeletionTimes;
         int lineCount = 0;
 
         for (int size : testSizes) {
@@ -816,73 +1258,124 @@ public:
             deletionRotations.push_back(deletion_rotations);
 
             cout << endl;
+
+            // Test AVL deletion
+            AVLTree avl;
+            for (const auto& post : testDataSet) {
+                avl.addPost(post.postId, post.timestamp, post.score);
+            }
+            int initial_avl_height = avl.getHeight();
+            avlInitialHeights.push_back(initial_avl_height);
+            long long initial_avl_count = avl.getNodeCount();
+            avl.resetRotationCount();
+
+            start = chrono::high_resolution_clock::now();
+            for (int i = 0; i < deleteCount; i++) {
+                avl.deletePost(testDataSet[i].postId);
+            }
+            end = chrono::high_resolution_clock::now();
+            double avl_time = chrono::duration<double, milli>(end - start).count();
+
+            int final_avl_height = avl.getHeight();
+            long long final_avl_count = avl.getNodeCount();
+            int avl_deletion_rotations = avl.getRotationCount();
+            avlFinalHeights.push_back(final_avl_height);
+            avlDeletionRotations.push_back(avl_deletion_rotations);
+
+            // Test B+ tree deletion (emptied leaves are unlinked, never merged)
+            BPlusTree bplus;
+            for (const auto& post : testDataSet) {
+                bplus.addPost(post.postId, post.timestamp, post.score);
+            }
+            int initial_bplus_height = bplus.getHeight();
+            bplusInitialHeights.push_back(initial_bplus_height);
+            long long initial_bplus_count = bplus.getNodeCount();
+
+            start = chrono::high_resolution_clock::now();
+            for (int i = 0; i < deleteCount; i++) {
+                bplus.deletePost(testDataSet[i].postId);
+            }
+            end = chrono::high_resolution_clock::now();
+            double bplus_time = chrono::duration<double, milli>(end - start).count();
+
+            int final_bplus_height = bplus.getHeight();
+            long long final_bplus_count = bplus.getNodeCount();
+            bplusFinalHeights.push_back(final_bplus_height);
+
+            // Same 30% via bulk eviction: test timestamps increase with the index,
+            // so the first 30% of posts are exactly the ones older than the cutoff
+            Treap evictionTreap;
+            for (const auto& post : testDataSet) {
+                evictionTreap.addPost(post.postId, post.timestamp, post.score);
+            }
+            start = chrono::high_resolution_clock::now();
+            long long evicted = evictionTreap.evictOlderThan(testDataSet[deleteCount].timestamp);
+            end = chrono::high_resolution_clock::now();
+            double eviction_time = chrono::duration<double, milli>(end - start).count();
             
             // Display results in table format
-            cout << "\n┌─────────────────────────────┬────────────┬────────────┬────────────┐" << endl;
-            cout << "│          Category           │    BST     │   Treap    │   Winner   │" << endl;
-            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+            int bst_height_change = initial_bst_height - final_bst_height;
+            int treap_height_change = initial_treap_height - final_treap_height;
+            int avl_height_change = initial_avl_height - final_avl_height;
+            int bplus_height_change = initial_bplus_height - final_bplus_height;
+            long long bst_deleted = initial_bst_count - final_bst_count;
+            long long treap_deleted = initial_treap_count - final_treap_count;
+            long long avl_deleted = initial_avl_count - final_avl_count;
+            long long bplus_deleted = initial_bplus_count - final_bplus_count;
+
+            cout << "\n┌─────────────────────────────┬────────────┬────────────┬────────────┬────────────┬────────────┐" << endl;
+            cout << "│          Category           │    BST     │   Treap    │    AVL     │     B+     │   Winner   │" << endl;
+            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
             
             // Deletion time row
             cout << "│ Deletion Time (ms)          │ " << setw(10) << fixed << setprecision(3) << bst_time 
-                << " │ " << setw(10) << fixed << setprecision(3) << treap_time << " │ ";
-            if (bst_time < treap_time) {
-                cout << "   BST     │" << endl;
-            } else {
-                cout << "  Treap    │" << endl;
-            }
+                << " │ " << setw(10) << treap_time << " │ " << setw(10) << avl_time
+                << " │ " << setw(10) << bplus_time << " │ "
+                << winnerLabel({{"BST", bst_time}, {"Treap", treap_time}, {"AVL", avl_time}, {"B+", bplus_time}}) << " │" << endl;
             
             // Initial height row
-            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
             cout << "│ Initial Height              │ " << setw(10) << initial_bst_height 
-                << " │ " << setw(10) << initial_treap_height << " │ ";
-            if (initial_bst_height < initial_treap_height) {
-                cout << "   BST     │" << endl;
-            } else {
-                cout << "  Treap    │" << endl;
-            }
+                << " │ " << setw(10) << initial_treap_height << " │ " << setw(10) << initial_avl_height
+                << " │ " << setw(10) << initial_bplus_height << " │ "
+                << winnerLabel({{"BST", (double)initial_bst_height}, {"Treap", (double)initial_treap_height},
+                                {"AVL", (double)initial_avl_height}, {"B+", (double)initial_bplus_height}}) << " │" << endl;
             
             // Final height row
-            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
             cout << "│ Final Height                │ " << setw(10) << final_bst_height 
-                << " │ " << setw(10) << final_treap_height << " │ ";
-            if (final_bst_height < final_treap_height) {
-                cout << "   BST     │" << endl;
-            } else {
-                cout << "  Treap    │" << endl;
-            }
+                << " │ " << setw(10) << final_treap_height << " │ " << setw(10) << final_avl_height
+                << " │ " << setw(10) << final_bplus_height << " │ "
+                << winnerLabel({{"BST", (double)final_bst_height}, {"Treap", (double)final_treap_height},
+                                {"AVL", (double)final_avl_height}, {"B+", (double)final_bplus_height}}) << " │" << endl;
             
-            // Height change row
-            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
-            int bst_height_change = initial_bst_height - final_bst_height;
-            int treap_height_change = initial_treap_height - final_treap_height;
+            // Height change row (larger reduction wins)
+            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
             cout << "│ Height Change               │ " << setw(10) << bst_height_change 
-                << " │ " << setw(10) << treap_height_change << " │ ";
-            if (bst_height_change > treap_height_change) {
-                cout << "   BST     │" << endl;
-            } else {
-                cout << "  Treap    │" << endl;
-            }
+                << " │ " << setw(10) << treap_height_change << " │ " << setw(10) << avl_height_change
+                << " │ " << setw(10) << bplus_height_change << " │ "
+                << winnerLabel({{"BST", (double)-bst_height_change}, {"Treap", (double)-treap_height_change},
+                                {"AVL", (double)-avl_height_change}, {"B+", (double)-bplus_height_change}}) << " │" << endl;
             
             // Rotations row
-            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
             cout << "│ Deletion Rotations          │     N/A    │ " << setw(10) << deletion_rotations 
-                << " │   Treap    │" << endl;
+                << " │ " << setw(10) << avl_deletion_rotations << " │     N/A    │ "
+                << winnerLabel({{"Treap", (double)deletion_rotations}, {"AVL", (double)avl_deletion_rotations}}) << " │" << endl;
             
             // Nodes deleted row
-            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
-            long long bst_deleted = initial_bst_count - final_bst_count;
-            long long treap_deleted = initial_treap_count - final_treap_count;
+            cout << "├─────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
             cout << "│ Nodes Deleted               │ " << setw(10) << bst_deleted 
-                << " │ " << setw(10) << treap_deleted << " │ ";
-            if (bst_deleted > treap_deleted) {
-                cout << "   BST     │" << endl;
-            } else if (treap_deleted > bst_deleted) {
-                cout << "  Treap    │" << endl;
-            } else {
+                << " │ " << setw(10) << treap_deleted << " │ " << setw(10) << avl_deleted
+                << " │ " << setw(10) << bplus_deleted << " │ ";
+            if (bst_deleted == treap_deleted && treap_deleted == avl_deleted && avl_deleted == bplus_deleted) {
                 cout << "   Tie     │" << endl;
+            } else {
+                cout << winnerLabel({{"BST", (double)-bst_deleted}, {"Treap", (double)-treap_deleted},
+                                     {"AVL", (double)-avl_deleted}, {"B+", (double)-bplus_deleted}}) << " │" << endl;
             }
             
-            cout << "└─────────────────────────────┴────────────┴────────────┴────────────┘" << endl;
+            cout << "└─────────────────────────────┴────────────┴────────────┴────────────┴────────────┴────────────┘" << endl;
             
             // Summary
             cout << "\n=== DELETION SUMMARY ===" << endl;
@@ -897,14 +1390,22 @@ public:
             }
             
             cout << "✅ Treap performed " << deletion_rotations << " rotations during deletion" << endl;
-            cout << "✅ Height reduction - BST: " << bst_height_change << ", Treap: " << treap_height_change << endl;
+            cout << "✅ AVL performed " << avl_deletion_rotations << " rebalancing rotations during deletion" << endl;
+            cout << "✅ Treap evictOlderThan() removed " << evicted << " posts in " << fixed << setprecision(3) 
+                << eviction_time << " ms (split + bulk free)" << endl;
+            cout << "✅ Height reduction - BST: " << bst_height_change << ", Treap: " << treap_height_change
+                << ", AVL: " << avl_height_change << ", B+: " << bplus_height_change << endl;
         
             bstDeletionTimes.push_back(bst_time);
             treapDeletionTimes.push_back(treap_time);
+            avlDeletionTimes.push_back(avl_time);
+            bplusDeletionTimes.push_back(bplus_time);
         }
 
         opMetrics.deletionTime_BST = calculateAverage(bstDeletionTimes);
         opMetrics.deletionTime_Treap = calculateAverage(treapDeletionTimes);
+        opMetrics.deletionTime_AVL = calculateAverage(avlDeletionTimes);
+        opMetrics.deletionTime_BPlus = calculateAverage(bplusDeletionTimes);
     
     
         // ADD THIS GRAPH CODE AT THE END OF THE FUNCTION (after the loop):
@@ -915,6 +1416,10 @@ public:
         for (int height : bstInitialHeights) pythonCmd += " " + to_string(height);
         for (int height : treapInitialHeights) pythonCmd += " " + to_string(height);
         for (int rotation : deletionRotations) pythonCmd += " " + to_string(rotation);
+        for (double time : avlDeletionTimes) pythonCmd += " " + to_string(time);
+        for (int height : avlInitialHeights) pythonCmd += " " + to_string(height);
+        for (double time : bplusDeletionTimes) pythonCmd += " " + to_string(time);
+        for (int height : bplusInitialHeights) pythonCmd += " " + to_string(height);
 
         // Add error checking
         int graphStatus = system(pythonCmd.c_str());
@@ -937,9 +1442,11 @@ public:
         // Use a larger dataset for meaningful query tests
         initializeTestData(10000);
         
-        // Build both trees
+        // Build every tree
         BinarySearchTree bst;
         Treap treap;
+        AVLTree avl;
+        BPlusTree bplus;
         
         cout << "Building trees for query tests..." << endl;
         int lineCount = 0;
@@ -976,42 +1483,76 @@ public:
             }
         }
         cout << endl;
+
+        // Build AVL and B+ tree
+        for (const auto& post : testDataSet) {
+            avl.addPost(post.postId, post.timestamp, post.score);
+            bplus.addPost(post.postId, post.timestamp, post.score);
+        }
         
-        cout << "Trees built - BST Height: " << bst.getHeight() << " | Treap Height: " << treap.getHeight() << endl;
+        cout << "Trees built - BST Height: " << bst.getHeight() << " | Treap Height: " << treap.getHeight()
+             << " | AVL Height: " << avl.getHeight() << " | B+ Height: " << bplus.getHeight() << endl;
         
+        // Result buffer shared by the list queries below (largest k is 50)
+        PostView recent[50];
+
         // Test 1: getMostPopular() - Single call vs Multiple calls
         cout << "\n--- getMostPopular() Performance ---" << endl;
         
         start = chrono::high_resolution_clock::now();
-        string bst_most_popular = bst.getMostPopular();
+        optional<PostView> bst_most_popular = bst.getMostPopular();
         auto end = chrono::high_resolution_clock::now();
         double bst_single_popular = chrono::duration<double, micro>(end - start).count();
         
         start = chrono::high_resolution_clock::now();
-        string treap_most_popular = treap.getMostPopular();
+        optional<PostView> treap_most_popular = treap.getMostPopular();
         end = chrono::high_resolution_clock::now();
         double treap_single_popular = chrono::duration<double, micro>(end - start).count();
         
+        start = chrono::high_resolution_clock::now();
+        optional<PostView> avl_most_popular = avl.getMostPopular();
+        end = chrono::high_resolution_clock::now();
+        double avl_single_popular = chrono::duration<double, micro>(end - start).count();
+
+        start = chrono::high_resolution_clock::now();
+        optional<PostView> bplus_most_popular = bplus.getMostPopular();
+        end = chrono::high_resolution_clock::now();
+        double bplus_single_popular = chrono::duration<double, micro>(end - start).count();
+        
         // Test 2: getMostRecent(k) with different k values
         cout << "\n--- getMostRecent(k) Performance ---" << endl;
         
         vector<int> k_values = {5, 10, 20, 50};
-        vector<double> bst_recent_times, treap_recent_times;
+        vector<double> bst_recent_times, treap_recent_times, avl_recent_times, bplus_recent_times;
         
         for (int k : k_values) {
             start = chrono::high_resolution_clock::now();
             for (int i = 0; i < 100; i++) {
-                bst.getMostRecent(k);
+                keep(bst.getMostRecent(k, recent));
             }
             end = chrono::high_resolution_clock::now();
             bst_recent_times.push_back(chrono::duration<double, micro>(end - start).count() / 100.0);
             
             start = chrono::high_resolution_clock::now();
             for (int i = 0; i < 100; i++) {
-                treap.getMostRecent(k);
+                keep(treap.getMostRecent(k, recent));
             }
             end = chrono::high_resolution_clock::now();
             treap_recent_times.push_back(chrono::duration<double, micro>(end - start).count() / 100.0);
+            
+            start = chrono::high_resolution_clock::now();
+            for (int i = 0; i < 100; i++) {
+                keep(avl.getMostRecent(k, recent));
+            }
+            end = chrono::high_resolution_clock::now();
+            avl_recent_times.push_back(chrono::duration<double, micro>(end - start).count() / 100.0);
+
+            start = chrono::high_resolution_clock::now();
+            for (int i = 0; i < 100; i++) {
+                keep(bplus.getMostRecent(k, recent));
+            }
+            end = chrono::high_resolution_clock::now();
+            bplus_recent_times.push_back(chrono::duration<double, micro>(end - start).count() / 100.0);
         }
         
         // Test 3: Mixed query workload
@@ -1019,80 +1560,138 @@ public:
         
         start = chrono::high_resolution_clock::now();
         for (int i = 0; i < 500; i++) {
-            if (i % 3 == 0) bst.getMostPopular();
-            else if (i % 3 == 1) bst.getMostRecent(5);
-            else bst.getMostRecent(15);
+            if (i % 3 == 0) keep(bst.getMostPopular());
+            else if (i % 3 == 1) keep(bst.getMostRecent(5, recent));
+            else keep(bst.getMostRecent(15, recent));
         }
         end = chrono::high_resolution_clock::now();
         double bst_mixed_time = chrono::duration<double, micro>(end - start).count() / 500.0;
         
         start = chrono::high_resolution_clock::now();
         for (int i = 0; i < 500; i++) {
-            if (i % 3 == 0) treap.getMostPopular();
-            else if (i % 3 == 1) treap.getMostRecent(5);
-            else treap.getMostRecent(15);
+            if (i % 3 == 0) keep(treap.getMostPopular());
+            else if (i % 3 == 1) keep(treap.getMostRecent(5, recent));
+            else keep(treap.getMostRecent(15, recent));
         }
         end = chrono::high_resolution_clock::now();
         double treap_mixed_time = chrono::duration<double, micro>(end - start).count() / 500.0;
         
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 500; i++) {
+            if (i % 3 == 0) keep(avl.getMostPopular());
+            else if (i % 3 == 1) keep(avl.getMostRecent(5, recent));
+            else keep(avl.getMostRecent(15, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double avl_mixed_time = chrono::duration<double, micro>(end - start).count() / 500.0;
+
+        start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < 500; i++) {
+            if (i % 3 == 0) keep(bplus.getMostPopular());
+            else if (i % 3 == 1) keep(bplus.getMostRecent(5, recent));
+            else keep(bplus.getMostRecent(15, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double bplus_mixed_time = chrono::duration<double, micro>(end - start).count() / 500.0;
+
+        // Test 4: topKByScore(window, 10) - "top 10 posts in a time window"
+        cout << "\n--- topKByScore(window, 10) Performance ---" << endl;
+
+        const long long firstTs = testDataSet.front().timestamp;
+        const long long windowSpan = 1000LL * 3600; // 1000 hours (~1000 posts)
+        const int windowCount = (int)testDataSet.size() - 1000;
+        vector<long long> windowStarts;
+        for (int i = 0; i < 200; i++) {
+            windowStarts.push_back(firstTs + (long long)(rand() % windowCount) * 3600);
+        }
+
+        start = chrono::high_resolution_clock::now();
+        for (long long from : windowStarts) {
+            keep(bst.topKByScore(from, from + windowSpan, 10, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double bst_topk_time = chrono::duration<double, micro>(end - start).count() / windowStarts.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (long long from : windowStarts) {
+            keep(treap.topKByScore(from, from + windowSpan, 10, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double treap_topk_time = chrono::duration<double, micro>(end - start).count() / windowStarts.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (long long from : windowStarts) {
+            keep(avl.topKByScore(from, from + windowSpan, 10, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double avl_topk_time = chrono::duration<double, micro>(end - start).count() / windowStarts.size();
+
+        start = chrono::high_resolution_clock::now();
+        for (long long from : windowStarts) {
+            keep(bplus.topKByScore(from, from + windowSpan, 10, recent));
+        }
+        end = chrono::high_resolution_clock::now();
+        double bplus_topk_time = chrono::duration<double, micro>(end - start).count() / windowStarts.size();
+        
         // Display results in table format
-        cout << "\n┌───────────────────────────────┬────────────┬────────────┬────────────┐" << endl;
-        cout << "│           Category            │    BST     │   Treap    │   Winner   │" << endl;
-        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "\n┌───────────────────────────────┬────────────┬────────────┬────────────┬────────────┬────────────┐" << endl;
+        cout << "│           Category            │    BST     │   Treap    │    AVL     │     B+     │   Winner   │" << endl;
+        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         
         // getMostPopular single row
         cout << "│ getMostPopular Single (μs)    │ " << setw(10) << fixed << setprecision(3) << bst_single_popular 
-            << " │ " << setw(10) << fixed << setprecision(3) << treap_single_popular << " │ ";
-        if (bst_single_popular < treap_single_popular) {
-            cout << "   BST    │" << endl;
-        } else {
-            cout << "  Treap   │" << endl;
-        }
+            << " │ " << setw(10) << treap_single_popular << " │ " << setw(10) << avl_single_popular
+            << " │ " << setw(10) << bplus_single_popular << " │ "
+            << winnerLabel({{"BST", bst_single_popular}, {"Treap", treap_single_popular}, {"AVL", avl_single_popular},
+                            {"B+", bplus_single_popular}}) << " │" << endl;
         
         // Mixed workload row
-        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         cout << "│ Mixed Workload (μs)           │ " << setw(10) << fixed << setprecision(3) << bst_mixed_time 
-            << " │ " << setw(10) << fixed << setprecision(3) << treap_mixed_time << " │ ";
-        if (bst_mixed_time < treap_mixed_time) {
-            cout << "   BST    │" << endl;
-        } else {
-            cout << "  Treap   │" << endl;
-        }
+            << " │ " << setw(10) << treap_mixed_time << " │ " << setw(10) << avl_mixed_time
+            << " │ " << setw(10) << bplus_mixed_time << " │ "
+            << winnerLabel({{"BST", bst_mixed_time}, {"Treap", treap_mixed_time}, {"AVL", avl_mixed_time},
+                            {"B+", bplus_mixed_time}}) << " │" << endl;
+        
+        // topKByScore row
+        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "│ topKByScore(window,10) (μs)   │ " << setw(10) << fixed << setprecision(3) << bst_topk_time 
+            << " │ " << setw(10) << treap_topk_time << " │ " << setw(10) << avl_topk_time
+            << " │ " << setw(10) << bplus_topk_time << " │ "
+            << winnerLabel({{"BST", bst_topk_time}, {"Treap", treap_topk_time}, {"AVL", avl_topk_time},
+                            {"B+", bplus_topk_time}}) << " │" << endl;
         
         // getMostRecent for different k values
-        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
         for (size_t i = 0; i < k_values.size(); i++) {
             cout << "│ getMostRecent(" << setw(2) << k_values[i] << ") (μs)        │ " 
                 << setw(10) << fixed << setprecision(3) << bst_recent_times[i] 
-                << " │ " << setw(10) << fixed << setprecision(3) << treap_recent_times[i] << " │ ";
-            if (bst_recent_times[i] < treap_recent_times[i]) {
-                cout << "   BST    │" << endl;
-            } else {
-                cout << "  Treap   │" << endl;
-            }
+                << " │ " << setw(10) << treap_recent_times[i] << " │ " << setw(10) << avl_recent_times[i]
+                << " │ " << setw(10) << bplus_recent_times[i] << " │ "
+                << winnerLabel({{"BST", bst_recent_times[i]}, {"Treap", treap_recent_times[i]}, {"AVL", avl_recent_times[i]},
+                                {"B+", bplus_recent_times[i]}})
+                << " │" << endl;
             if (i < k_values.size() - 1) {
-                cout << "├───────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
+                cout << "├───────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
             }
         }
         
-        // Performance summary row
-        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┤" << endl;
-        double popular_speedup = bst_single_popular / treap_single_popular;
-        double mixed_speedup = bst_mixed_time / treap_mixed_time;
-        cout << "│ Overall Speed Multiplier      │" << setw(10) << fixed << setprecision(1) << popular_speedup 
-            << "x │ " << setw(9) << fixed << setprecision(1) << mixed_speedup << "x │ ";
-        if (popular_speedup > 1.0 || mixed_speedup > 1.0) {
-            cout << "  Treap   │" << endl;
-        } else {
-            cout << "   BST    │" << endl;
-        }
+        // Performance summary row: mixed workload speed relative to the BST
+        cout << "├───────────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤" << endl;
+        double treap_speedup = bst_mixed_time / treap_mixed_time;
+        double avl_speedup = bst_mixed_time / avl_mixed_time;
+        double bplus_speedup = bst_mixed_time / bplus_mixed_time;
+        cout << "│ Overall Speed Multiplier      │       1.0x │ " << setw(9) << fixed << setprecision(1) << treap_speedup
+            << "x │ " << setw(9) << avl_speedup << "x │ " << setw(9) << bplus_speedup << "x │ "
+            << winnerLabel({{"BST", 1.0}, {"Treap", 1.0 / treap_speedup}, {"AVL", 1.0 / avl_speedup},
+                            {"B+", 1.0 / bplus_speedup}}) << " │" << endl;
         
-        cout << "└───────────────────────────────┴────────────┴────────────┴────────────┘" << endl;
+        cout << "└───────────────────────────────┴────────────┴────────────┴────────────┴────────────┴────────────┘" << endl;
         
         // Summary
         cout << "\n=== QUERY PERFORMANCE SUMMARY ===" << endl;
-        cout << "Most Popular Post - BST: " << bst_most_popular.substr(0, 50) << "..." << endl;
-        cout << "Most Popular Post - Treap: " << treap_most_popular.substr(0, 50) << "..." << endl;
+        printPopular({{"BST", bst_most_popular}, {"Treap", treap_most_popular}, {"AVL", avl_most_popular},
+                      {"B+", bplus_most_popular}});
         
         if (treap_single_popular < bst_single_popular) {
             cout << "✅ Treap dominates getMostPopular() - " << fixed << setprecision(1) 
@@ -1102,13 +1701,20 @@ public:
         if (treap_mixed_time < bst_mixed_time) {
             cout << "✅ Treap wins mixed workload - better for real-world scenarios" << endl;
         }
+
+        if (treap_topk_time < bst_topk_time) {
+            cout << "✅ Treap heap order prunes topKByScore() - " << fixed << setprecision(1) 
+                << (bst_topk_time / treap_topk_time) << "x faster than scanning the window" << endl;
+        }
         
         // Analyze getMostRecent performance trends
         cout << "\n=== getMostRecent(k) ANALYSIS ===" << endl;
         for (size_t i = 0; i < k_values.size(); i++) {
             double speedup = bst_recent_times[i] / treap_recent_times[i];
             cout << "k=" << k_values[i] << ": BST=" << fixed << setprecision(3) << bst_recent_times[i] 
-                << "μs, Treap=" << treap_recent_times[i] << "μs, Speedup=" << fixed << setprecision(1) << speedup << "x" << endl;
+                << "μs, Treap=" << treap_recent_times[i] << "μs, AVL=" << avl_recent_times[i]
+                << "μs, B+=" << bplus_recent_times[i]
+                << "μs, Speedup=" << fixed << setprecision(1) << speedup << "x" << endl;
         }
 
         // Graph for query performance
@@ -1125,6 +1731,27 @@ public:
         for (double time : bst_recent_times) pythonCmd += " " + to_string(time);
         for (double time : treap_recent_times) pythonCmd += " " + to_string(time);
 
+        // Add top-k window times
+        pythonCmd += " " + to_string(bst_topk_time);
+        pythonCmd += " " + to_string(treap_topk_time);
+
+        // Add AVL times
+        pythonCmd += " " + to_string(avl_single_popular);
+        pythonCmd += " " + to_string(avl_mixed_time);
+        for (double time : avl_recent_times) pythonCmd += " " + to_string(time);
+        pythonCmd += " " + to_string(avl_topk_time);
+
+        // Add B+ tree times
+        pythonCmd += " " + to_string(bplus_single_popular);
+        pythonCmd += " " + to_string(bplus_mixed_time);
+        for (double time : bplus_recent_times) pythonCmd += " " + to_string(time);
+        pythonCmd += " " + to_string(bplus_topk_time);
+
+        opMetrics.queryTime_BST = bst_mixed_time;
+        opMetrics.queryTime_Treap = treap_mixed_time;
+        opMetrics.queryTime_AVL = avl_mixed_time;
+        opMetrics.queryTime_BPlus = bplus_mixed_time;
+
         int graphStatus = system(pythonCmd.c_str());
         cout << "📊 Query performance graph closed. Continuing..." << endl;
     
@@ -1136,11 +1763,11 @@ public:
 
     void runFinalComprehensiveAnalysis() {
         cout << "\n" << string(70, '=') << endl;
-        cout << "🏆 FINAL COMPREHENSIVE ANALYSIS - BST vs TREAP" << endl;
+        cout << "🏆 FINAL COMPREHENSIVE ANALYSIS - BST vs TREAP vs AVL vs B+" << endl;
         cout << string(70, '=') << endl;
         
         // Reset cumulative metrics
-        opMetrics = {0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+        opMetrics = OperationMetrics();
         
         // Run all tests
         testInsertionPerformance();
@@ -1156,35 +1783,7 @@ public:
     /// Print comparison table for final analysis
 
     void printComparisonTable() {
-        cout << "┌──────────────────────────────────────┬──────────────────────┬──────────────────────┐" << endl;
-        cout << "│              Metrics                 │        Treaps        │  Binary Search Tree  │" << endl;
-        cout << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-        
-        // Insertion Time
-        cout << "│ Insertion Time (avg)                 │ " << setw(17) << fixed << setprecision(3) << opMetrics.insertionTime_Treap 
-            << " ms │ " << setw(17) << opMetrics.insertionTime_BST << " ms │" << endl;
-        
-        // Deletion Time  
-        cout << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-        cout << "│ Deletion Time (avg)                  │ " << setw(17) << opMetrics.deletionTime_Treap 
-            << " ms │ " << setw(17) << opMetrics.deletionTime_BST << " ms │" << endl;
-        
-        // Search Time
-        cout << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-        cout << "│ Search Time (avg)                    │ " << setw(17) << opMetrics.searchTime_Treap 
-            << " μs │ " << setw(17) << opMetrics.searchTime_BST << " μs │" << endl;
-        
-        // Height of the Tree
-        cout << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-        cout << "│ Height of the Tree                   │ " << setw(17) << opMetrics.treeHeight_Treap 
-            << "    │ " << setw(17) << opMetrics.treeHeight_BST << "    │" << endl;
-        
-        // Tree Balancing Factor
-// Tree Balancing Factor - show as percentage
-        cout << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-        cout << "│ Tree Balancing Factor                │ " << setw(17) << fixed << setprecision(1) << (opMetrics.balancingFactor_Treap * 100) 
-            << " %  │ " << setw(17) << (opMetrics.balancingFactor_BST * 100) << " %  │" << endl;        
-        cout << "└──────────────────────────────────────┴──────────────────────┴──────────────────────┘" << endl;
+        writeComparisonTable(cout);
     }
 
     /// Save results to a text file
@@ -1195,45 +1794,7 @@ public:
         ofstream file("comparison_analysis.txt");
         
         if (file.is_open()) {
-            file << "┌──────────────────────────────────────┬──────────────────────┬──────────────────────┐" << endl;
-            file << "│              Metrics                 │        Treaps        │  Binary Search Tree  │" << endl;
-            file << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-            
-            // Insertion Time
-            file << "│ Insertion Time (avg)                 │ " << setw(17) << fixed << setprecision(3) << opMetrics.insertionTime_Treap 
-                << " ms │ " << setw(17) << opMetrics.insertionTime_BST << " ms │" << endl;
-            
-            // Deletion Time  
-            file << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-            file << "│ Deletion Time (avg)                  │ " << setw(17) << opMetrics.deletionTime_Treap 
-                << " ms │ " << setw(17) << opMetrics.deletionTime_BST << " ms │" << endl;
-            
-            // Search Time
-            file << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-            file << "│ Search Time (avg)                    │ " << setw(17) << opMetrics.searchTime_Treap 
-                << " μs │ " << setw(17) << opMetrics.searchTime_BST << " μs │" << endl;
-  
-            // Query Time
-            file << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-            file << "│ Query Time (avg)                     │ " << setw(17) << opMetrics.queryTime_Treap 
-                << " μs │ " << setw(17) << opMetrics.queryTime_BST << " μs │" << endl;
-  
-            // Like post Time
-            file << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-            file << "│ Like Post Time (avg)                 │ " << setw(17) << opMetrics.likeTime_Treap 
-                << " μs │ " << setw(17) << opMetrics.likeTime_BST << " μs │" << endl;
-  
-            // Height of the Tree
-            file << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-            file << "│ Height of the Tree                   │ " << setw(17) << opMetrics.treeHeight_Treap 
-                << "    │ " << setw(17) << opMetrics.treeHeight_BST << "    │" << endl;
-            
-            // Tree Balancing Factor
-            file << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┤" << endl;
-            file << "│ Tree Balancing Factor                │ " << setw(17) << fixed << setprecision(1) << (opMetrics.balancingFactor_Treap * 100) 
-                << " %  │ " << setw(17) << (opMetrics.balancingFactor_BST * 100) << " %  │" << endl;        
-            file << "└──────────────────────────────────────┴──────────────────────┴──────────────────────┘" << endl;
-            
+            writeComparisonTable(file);
             file.close();
             cout << "✅ Operation results saved successfully!" << endl;
         }
@@ -1242,10 +1803,99 @@ public:
         }
     }
 
+    /// Operation metrics of every structure, one column each
+
+    void writeComparisonTable(ostream& out) {
+        out << "┌──────────────────────────────────────┬──────────────────────┬──────────────────────┬──────────────────────┬──────────────────────┐" << endl;
+        out << "│              Metrics                 │        Treaps        │  Binary Search Tree  │       AVL Tree       │       B+ Tree        │" << endl;
+        out << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┤" << endl;
+        
+        // Insertion Time
+        out << "│ Insertion Time (avg)                 │ " << setw(17) << fixed << setprecision(3) << opMetrics.insertionTime_Treap 
+            << " ms │ " << setw(17) << opMetrics.insertionTime_BST << " ms │ " << setw(17) << opMetrics.insertionTime_AVL
+            << " ms │ " << setw(17) << opMetrics.insertionTime_BPlus << " ms │" << endl;
+        
+        // Deletion Time  
+        out << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┤" << endl;
+        out << "│ Deletion Time (avg)                  │ " << setw(17) << opMetrics.deletionTime_Treap 
+            << " ms │ " << setw(17) << opMetrics.deletionTime_BST << " ms │ " << setw(17) << opMetrics.deletionTime_AVL
+            << " ms │ " << setw(17) << opMetrics.deletionTime_BPlus << " ms │" << endl;
+        
+        // Search Time
+        out << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┤" << endl;
+        out << "│ Search Time (avg)                    │ " << setw(17) << opMetrics.searchTime_Treap 
+            << " μs │ " << setw(17) << opMetrics.searchTime_BST << " μs │ " << setw(17) << opMetrics.searchTime_AVL
+            << " μs │ " << setw(17) << opMetrics.searchTime_BPlus << " μs │" << endl;
+
+        // Query Time
+        out << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┤" << endl;
+        out << "│ Query Time (avg)                     │ " << setw(17) << opMetrics.queryTime_Treap 
+            << " μs │ " << setw(17) << opMetrics.queryTime_BST << " μs │ " << setw(17) << opMetrics.queryTime_AVL
+            << " μs │ " << setw(17) << opMetrics.queryTime_BPlus << " μs │" << endl;
+
+        // Like post Time
+        out << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┤" << endl;
+        out << "│ Like Post Time (avg)                 │ " << setw(17) << opMetrics.likeTime_Treap 
+            << " μs │ " << setw(17) << opMetrics.likeTime_BST << " μs │ " << setw(17) << opMetrics.likeTime_AVL
+            << " μs │ " << setw(17) << opMetrics.likeTime_BPlus << " μs │" << endl;
+        
+        // Height of the Tree
+        out << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┤" << endl;
+        out << "│ Height of the Tree                   │ " << setw(17) << opMetrics.treeHeight_Treap 
+            << "    │ " << setw(17) << opMetrics.treeHeight_BST << "    │ " << setw(17) << opMetrics.treeHeight_AVL
+            << "    │ " << setw(17) << opMetrics.treeHeight_BPlus << "    │" << endl;
+        
+        // Tree Balancing Factor - show as percentage
+        out << "├──────────────────────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┼──────────────────────┤" << endl;
+        out << "│ Tree Balancing Factor                │ " << setw(17) << fixed << setprecision(1) << (opMetrics.balancingFactor_Treap * 100) 
+            << " %  │ " << setw(17) << (opMetrics.balancingFactor_BST * 100) << " %  │ " << setw(17) << (opMetrics.balancingFactor_AVL * 100)
+            << " %  │ " << setw(17) << (opMetrics.balancingFactor_BPlus * 100) << " %  │" << endl;
+        out << "└──────────────────────────────────────┴──────────────────────┴──────────────────────┴──────────────────────┴──────────────────────┘" << endl;
+    }
+
     ////////////////////////////////////////////////
     ////////////////// Utilities ///////////////////
     ////////////////////////////////////////////////
 
+    /// Winner column label: name of the lowest value, centred in 10 columns
+    /// (ties go to the structure listed first)
+
+    string winnerLabel(const vector<pair<string, double>>& entries) {
+        size_t best = 0;
+        for (size_t i = 1; i < entries.size(); i++) {
+            if (entries[i].second < entries[best].second) best = i;
+        }
+        const string& name = entries[best].first;
+        size_t padding = name.size() < 10 ? 10 - name.size() : 0;
+        return string(padding / 2, ' ') + name + string((padding + 1) / 2, ' ');
+    }
+
+    /// Keep a benchmarked result alive so the optimiser cannot drop the
+    /// call that produced it
+
+    template <typename T>
+    static void keep(const T& result) {
+        asm volatile("" : : "g"(&result) : "memory");
+    }
+
+    /// Most popular post of each structure, one table row per structure
+
+    void printPopular(const vector<pair<string, optional<PostView>>>& entries) {
+        cout << "┌────────────┬──────────────────┬────────────┬──────────────┐" << endl;
+        cout << "│ Structure  │ Most Popular ID  │   Score    │  Timestamp   │" << endl;
+        cout << "├────────────┼──────────────────┼────────────┼──────────────┤" << endl;
+        for (const auto& [label, post] : entries) {
+            cout << "│ " << setw(10) << left << label << " │ " << setw(16) << (post ? string(post->postId) : "none")
+                << right << " │ ";
+            if (post) {
+                cout << setw(10) << post->score << " │ " << setw(12) << post->timestamp << " │" << endl;
+            } else {
+                cout << setw(10) << "-" << " │ " << setw(12) << "-" << " │" << endl;
+            }
+        }
+        cout << "└────────────┴──────────────────┴────────────┴──────────────┘" << endl;
+    }
+
     /// Helper function to calculate average of a vector of doubles
 
     double calculateAverage(const vector<double>& values) {
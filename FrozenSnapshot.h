@@ -0,0 +1,224 @@
+#ifndef FROZEN_SNAPSHOT_H
+#define FROZEN_SNAPSHOT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <optional>
+
+#include "Post.h"
+
+using namespace std;
+
+// Read-only, pointer-free copy of a tree, taken with freeze().
+// Queries return PostViews whose postId points into the snapshot's own
+// character buffer, valid for as long as the snapshot is.
+//
+// Posts are stored by rank (their position in (timestamp, postId) order)
+// as parallel arrays, with all post IDs packed into one buffer. Searches go
+// through a second copy of the timestamps in Eytzinger (BFS) order: the
+// first levels of the implicit tree share a handful of cache lines, the
+// descent is a branchless index update, and the grandchildren sixteen
+// slots ahead are prefetched while the current level is compared.
+//
+// The snapshot does not follow later changes to the tree - freeze again
+// after updates.
+class FrozenSnapshot {
+private:
+    // Sorted (rank) order
+    vector<long long> timestamps;
+    vector<int> scores;
+    vector<uint32_t> idOffsets; // Post r's ID is idChars[idOffsets[r], idOffsets[r + 1])
+    string idChars;
+
+    // Eytzinger order, 1-based: slot i has children 2i and 2i + 1
+    vector<long long> eytzinger;
+    vector<uint32_t> eytzingerRank; // Rank of the post stored in each slot
+
+    size_t popular; // Rank of the highest-scoring post (oldest on ties)
+
+    static constexpr size_t PREFETCH_DISTANCE = 16; // Four levels ahead
+
+    // Lay the sorted timestamps out in Eytzinger order. Slots are visited
+    // in-order (leftmost slot first, then successor), so the k-th visited
+    // slot receives rank k - O(n), no recursion
+    void buildEytzinger() {
+        size_t n = timestamps.size();
+        eytzinger.assign(n + 1, LLONG_MIN);
+        eytzingerRank.assign(n + 1, 0);
+        if (n == 0) return;
+
+        size_t slot = 1;
+        while (2 * slot <= n) slot *= 2;
+
+        for (size_t rank = 0; rank < n; rank++) {
+            eytzinger[slot] = timestamps[rank];
+            eytzingerRank[slot] = (uint32_t)rank;
+
+            if (2 * slot + 1 <= n) {
+                slot = 2 * slot + 1; // Leftmost slot of the right subtree
+                while (2 * slot <= n) slot *= 2;
+            } else {
+                while (slot & 1) slot >>= 1; // Climb out of right subtrees
+                slot >>= 1;
+            }
+        }
+    }
+
+    void append(string_view postId, long long timestamp, int score) {
+        if (scores.empty() || score > scores[popular]) popular = scores.size();
+        timestamps.push_back(timestamp);
+        scores.push_back(score);
+        idChars.append(postId.data(), postId.size());
+        idOffsets.push_back((uint32_t)idChars.size());
+    }
+
+public:
+    // Ranks [first, last) of a snapshot, oldest first
+    class Range {
+    private:
+        const FrozenSnapshot* snapshot;
+        size_t first, last;
+
+    public:
+        class Iterator {
+        private:
+            const FrozenSnapshot* snapshot;
+            size_t rank;
+
+        public:
+            using iterator_category = forward_iterator_tag;
+            using value_type = PostView;
+            using difference_type = ptrdiff_t;
+            using pointer = const PostView*;
+            using reference = PostView;
+
+            Iterator(const FrozenSnapshot* snapshot, size_t rank) : snapshot(snapshot), rank(rank) {}
+
+            PostView operator*() const { return snapshot->at(rank); }
+
+            Iterator& operator++() {
+                rank++;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator old = *this;
+                rank++;
+                return old;
+            }
+
+            bool operator==(const Iterator& other) const { return rank == other.rank; }
+            bool operator!=(const Iterator& other) const { return rank != other.rank; }
+        };
+
+        Range(const FrozenSnapshot* snapshot, size_t first, size_t last)
+            : snapshot(snapshot), first(first), last(last) {}
+
+        bool empty() const { return first == last; }
+        size_t size() const { return last - first; }
+        Iterator begin() const { return Iterator(snapshot, first); }
+        Iterator end() const { return Iterator(snapshot, last); }
+    };
+
+    FrozenSnapshot() : idOffsets(1, 0), popular(0) {}
+
+    // Copy posts from any in-order sequence of nodes with postId,
+    // timestamp and score members (e.g. a tree's PostRange)
+    template <typename Sequence>
+    FrozenSnapshot(const Sequence& posts, size_t count) : idOffsets(1, 0), popular(0) {
+        timestamps.reserve(count);
+        scores.reserve(count);
+        idOffsets.reserve(count + 1);
+        for (const auto& post : posts) {
+            append(post.postId, post.timestamp, post.score);
+        }
+        buildEytzinger();
+    }
+
+    FrozenSnapshot(FrozenSnapshot&&) = default;
+    FrozenSnapshot& operator=(FrozenSnapshot&&) = default;
+
+    size_t size() const { return timestamps.size(); }
+    bool empty() const { return timestamps.empty(); }
+
+    string_view idOf(size_t rank) const {
+        return string_view(idChars.data() + idOffsets[rank], idOffsets[rank + 1] - idOffsets[rank]);
+    }
+
+    PostView at(size_t rank) const {
+        return PostView{idOf(rank), timestamps[rank], scores[rank]};
+    }
+
+    // Rank of the first post with timestamp >= t (size() if none) -
+    // O(log n), branch-free apart from the loop condition
+    size_t lowerBound(long long t) const {
+        size_t n = timestamps.size();
+        const long long* keys = eytzinger.data();
+
+        size_t slot = 1;
+        while (slot <= n) {
+            __builtin_prefetch(keys + min(slot * PREFETCH_DISTANCE, n));
+            slot = 2 * slot + (keys[slot] < t);
+        }
+        // Undo the trailing right turns plus the last left turn - that
+        // left turn was taken at the answer
+        slot >>= __builtin_ffsll((long long)~slot);
+
+        return slot == 0 ? n : eytzingerRank[slot];
+    }
+
+    // Rank of the first post with timestamp > t (size() if none)
+    size_t upperBound(long long t) const {
+        return t == LLONG_MAX ? timestamps.size() : lowerBound(t + 1);
+    }
+
+    // Whether the post with this (timestamp, postId) is in the snapshot -
+    // O(log n) plus a scan over posts sharing the timestamp
+    bool contains(long long timestamp, const string& postId) const {
+        for (size_t rank = lowerBound(timestamp); rank < timestamps.size() && timestamps[rank] == timestamp; rank++) {
+            if (idOf(rank) == postId) return true;
+        }
+        return false;
+    }
+
+    // Number of posts with t1 <= timestamp <= t2 - O(log n)
+    long long countInRange(long long t1, long long t2) const {
+        if (t1 > t2) return 0;
+        return (long long)(upperBound(t2) - lowerBound(t1));
+    }
+
+    // Posts with from <= timestamp <= to, oldest first - O(log n + k)
+    Range rangeQuery(long long from, long long to) const {
+        if (from > to) return Range(this, 0, 0);
+        return Range(this, lowerBound(from), upperBound(to));
+    }
+
+    // Most popular post - O(1), precomputed while freezing
+    optional<PostView> getMostPopular() const {
+        if (empty()) return nullopt;
+        return at(popular);
+    }
+
+    // k most recent posts, newest first, written to out (room for k) - O(k)
+    // off the end of the arrays. Returns how many were written.
+    size_t getMostRecent(int k, PostView* out) const {
+        size_t n = timestamps.size();
+        size_t count = min((size_t)max(k, 0), n);
+        for (size_t taken = 0; taken < count; taken++) {
+            out[taken] = at(n - 1 - taken);
+        }
+        return count;
+    }
+
+    // Bytes held by the arrays of this snapshot
+    size_t memoryBytes() const {
+        return timestamps.capacity() * sizeof(long long) + scores.capacity() * sizeof(int) +
+               idOffsets.capacity() * sizeof(uint32_t) + idChars.capacity() +
+               eytzinger.capacity() * sizeof(long long) + eytzingerRank.capacity() * sizeof(uint32_t);
+    }
+};
+
+#endif // FROZEN_SNAPSHOT_H
@@ -0,0 +1,237 @@
+#ifndef INGEST_PIPELINE_H
+#define INGEST_PIPELINE_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+using namespace std;
+
+// Building blocks of the staged dataset loader in PostLoader:
+//
+//   decompress x D --chunks--> parse x N --batches--> insert (caller's thread)
+//
+// Stages hand work over through BoundedQueues and count what they process
+// and how long they sat waiting on a neighbour, so a finished load can name
+// its bottleneck: the stage that almost never waited.
+
+// Bounded lock-free multi-producer / multi-consumer ring (Vyukov's
+// sequence-numbered cells). Each cell's sequence says whose turn it is:
+// pos for the producer claiming it, pos + 1 for the consumer. Producers
+// and consumers only contend on their own position counter.
+template <typename T>
+class BoundedQueue {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T value;
+    };
+
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueuePos;
+    alignas(64) atomic<size_t> dequeuePos;
+    alignas(64) atomic<bool> closed;
+
+    // Spin briefly, then yield, then sleep - a starved stage should not
+    // keep a core busy
+    static void backOff(int& spins) {
+        spins++;
+        if (spins < 64) return;
+        if (spins < 256) {
+            this_thread::yield();
+        } else {
+            this_thread::sleep_for(chrono::microseconds(50));
+        }
+    }
+
+    static long long nanosSince(chrono::steady_clock::time_point start) {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    }
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit BoundedQueue(size_t capacity) : enqueuePos(0), dequeuePos(0), closed(false) {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Moves value in and returns true, or returns false if the ring is full
+    bool tryPush(T& value) {
+        Cell* cell;
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t sequence = cell->sequence.load(memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Consumers have not freed this cell yet
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    // Moves the oldest value out and returns true, or returns false if empty
+    bool tryPop(T& value) {
+        Cell* cell;
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t sequence = cell->sequence.load(memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Producers have not filled this cell yet
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->value);
+        cell->sequence.store(pos + mask + 1, memory_order_release);
+        return true;
+    }
+
+    // Push, waiting while the ring is full. Returns false (value dropped)
+    // if stop is raised first. Time spent waiting is added to waitNanos.
+    bool push(T&& value, const atomic<bool>& stop, atomic<long long>& waitNanos) {
+        if (tryPush(value)) return true;
+
+        auto start = chrono::steady_clock::now();
+        int spins = 0;
+        bool pushed = false;
+        while (!stop.load(memory_order_relaxed)) {
+            if (tryPush(value)) {
+                pushed = true;
+                break;
+            }
+            backOff(spins);
+        }
+        waitNanos.fetch_add(nanosSince(start), memory_order_relaxed);
+        return pushed;
+    }
+
+    // Pop, waiting while the ring is empty. Returns false once the queue is
+    // closed and drained, or when stop is raised.
+    bool pop(T& value, const atomic<bool>& stop, atomic<long long>& waitNanos) {
+        if (tryPop(value)) return true;
+
+        auto start = chrono::steady_clock::now();
+        int spins = 0;
+        bool popped = false;
+        while (!stop.load(memory_order_relaxed)) {
+            if (tryPop(value)) {
+                popped = true;
+                break;
+            }
+            if (closed.load(memory_order_acquire)) {
+                popped = tryPop(value); // Pushes that finished before close()
+                break;
+            }
+            backOff(spins);
+        }
+        waitNanos.fetch_add(nanosSince(start), memory_order_relaxed);
+        return popped;
+    }
+
+    // No more pushes will come; consumers drain what is left and stop
+    void close() { closed.store(true, memory_order_release); }
+};
+
+// What one stage got through, updated by its thread(s) as it runs
+struct StageCounters {
+    atomic<long long> items{0};     // Chunks, records or posts handed on
+    atomic<long long> bytes{0};     // Input bytes consumed
+    atomic<long long> waitNanos{0}; // Blocked on an empty input or a full output queue
+    int threads = 1;
+
+    double waitSeconds() const { return waitNanos.load() / 1e9; }
+
+    // Share of the stage's thread time spent waiting on a neighbour
+    double waitShare(double wallSeconds) const {
+        if (wallSeconds <= 0) return 0.0;
+        return waitSeconds() / (wallSeconds * threads);
+    }
+};
+
+// Position of a chunk in the decoded stream: a run of parts that belong
+// together (a stream, one zstd frame's records, or the record straddling
+// two frames) and the part's index within it. Runs and parts are numbered
+// from 0 without gaps, and the last part of each run is flagged, so the
+// insert stage can put batches back into file order.
+struct ChunkOrder {
+    uint64_t run = 0;
+    uint32_t part = 0;
+    bool lastPart = true;
+
+    bool operator<(const ChunkOrder& other) const {
+        return run != other.run ? run < other.run : part < other.part;
+    }
+
+    // The position that comes after this one
+    ChunkOrder next() const {
+        return lastPart ? ChunkOrder{run + 1, 0, true} : ChunkOrder{run, part + 1, true};
+    }
+
+    bool samePlace(const ChunkOrder& other) const { return run == other.run && part == other.part; }
+};
+
+// Decoded text for one parse task: whole records in text[begin, size())
+struct TextChunk {
+    ChunkOrder order;
+    string text;
+    size_t begin = 0;
+};
+
+// Posts parsed from one chunk. IDs are packed into one buffer so a batch
+// costs two allocations however many posts it holds.
+struct PostBatch {
+    struct Entry {
+        uint32_t idOffset;
+        uint32_t idLength;
+        long long timestamp;
+        int score;
+    };
+
+    ChunkOrder order; // Of the chunk the posts came from
+    string ids;
+    vector<Entry> entries;
+
+    void add(string_view id, long long timestamp, int score) {
+        entries.push_back(Entry{(uint32_t)ids.size(), (uint32_t)id.size(), timestamp, score});
+        ids.append(id.data(), id.size());
+    }
+
+    string_view idOf(const Entry& entry) const {
+        return string_view(ids.data() + entry.idOffset, entry.idLength);
+    }
+};
+
+// Counters of the three stages of one load
+struct PipelineStats {
+    StageCounters decompress; // items = chunks, bytes = decompressed bytes
+    StageCounters parse;      // items = records parsed, bytes = chunk bytes scanned
+    StageCounters insert;     // items = posts handed to the sink
+    double seconds = 0.0;     // Wall time of the whole pipeline
+};
+
+#endif // INGEST_PIPELINE_H
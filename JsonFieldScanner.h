@@ -0,0 +1,205 @@
+#ifndef JSON_FIELD_SCANNER_H
+#define JSON_FIELD_SCANNER_H
+
+#include <string_view>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+// Pulls the top-level "id", "created_utc" and "score" out of one JSON
+// record (a Pushshift submission line) in a single pass, without building
+// a document.
+//
+// The record is classified 64 bytes at a time into bitmasks - quotes,
+// backslashes, braces/brackets, colons, commas - with SSE2 compares where
+// available (simdjson-style). Escaped quotes are removed with the
+// odd-backslash-run trick, and a prefix XOR over the remaining quotes marks
+// the bytes inside strings, so only real structure is visited: the scanner
+// walks the set bits, tracks nesting depth and reads a value only after a
+// key at depth 1. Fields of nested objects ("media": {"id": ...}) and
+// lookalikes inside strings are never matched. created_utc and score may
+// be numbers or numeric strings ("1600000000", or 1600000000.0).
+class JsonFieldScanner {
+private:
+    static constexpr uint64_t EVEN_BITS = 0x5555555555555555ULL;
+
+    struct BlockMasks {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t open;  // { or [
+        uint64_t close; // } or ]
+        uint64_t colon;
+        uint64_t comma;
+    };
+
+    // Bit i of each mask is set when block[i] is that character.
+    // '{' / '[' and '}' / ']' differ only in bit 0x20, so one compare
+    // against the lowercase form covers both.
+    static BlockMasks classify(const char* block) {
+        BlockMasks masks{0, 0, 0, 0, 0, 0};
+#if defined(__SSE2__)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i open = _mm_set1_epi8('{');
+        const __m128i close = _mm_set1_epi8('}');
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        for (int lane = 0; lane < 4; lane++) {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(block + 16 * lane));
+            __m128i folded = _mm_or_si128(bytes, caseBit);
+            int shift = 16 * lane;
+            masks.quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)) << shift;
+            masks.backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, backslash)) << shift;
+            masks.open |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(folded, open)) << shift;
+            masks.close |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(folded, close)) << shift;
+            masks.colon |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, colon)) << shift;
+            masks.comma |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, comma)) << shift;
+        }
+#else
+        for (int i = 0; i < 64; i++) {
+            uint64_t bit = 1ULL << i;
+            char c = block[i];
+            char folded = (char)(c | 0x20);
+            if (c == '"') masks.quote |= bit;
+            if (c == '\\') masks.backslash |= bit;
+            if (folded == '{') masks.open |= bit;
+            if (folded == '}') masks.close |= bit;
+            if (c == ':') masks.colon |= bit;
+            if (c == ',') masks.comma |= bit;
+        }
+#endif
+        return masks;
+    }
+
+    // Characters escaped by a backslash: those after an odd-length run of
+    // backslashes. carry is 1 when the previous block ended mid-escape.
+    static uint64_t escapedChars(uint64_t backslash, uint64_t& carry) {
+        backslash &= ~carry;
+        uint64_t followsEscape = (backslash << 1) | carry;
+        uint64_t oddStarts = backslash & ~EVEN_BITS & ~followsEscape;
+        uint64_t evenStartRuns;
+        carry = __builtin_add_overflow(oddStarts, backslash, &evenStartRuns) ? 1 : 0;
+        uint64_t invert = evenStartRuns << 1;
+        return (EVEN_BITS ^ invert) & followsEscape;
+    }
+
+    // Bit i = XOR of bits 0..i: set from an opening quote up to (not
+    // including) its closing quote
+    static uint64_t prefixXor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    // Integer at p (after spaces), bare or inside quotes; a fraction is
+    // ignored. Returns false if there is no number there.
+    template <typename Int>
+    static bool parseInteger(const char* p, const char* end, Int& value) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (p < end && *p == '"') p++;
+        return from_chars(p, end, value).ec == errc();
+    }
+
+    // String value at p (after spaces), without its quotes
+    static bool parseString(const char* p, const char* end, string_view& value) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (p == end || *p != '"') return false;
+        const char* close = (const char*)memchr(p + 1, '"', end - p - 1);
+        if (!close || close == p + 1) return false;
+        value = string_view(p + 1, close - p - 1);
+        return true;
+    }
+
+public:
+    // Returns false if any of the three fields is missing at the top level
+    // or does not hold a value of the right kind
+    static bool scan(string_view record, string_view& id, long long& createdUtc, int& score) {
+        enum : int { ID = 1, CREATED = 2, SCORE = 4, ALL = 7 };
+
+        const char* data = record.data();
+        const char* end = data + record.size();
+        char padded[64];
+
+        uint64_t escapeCarry = 0;
+        uint64_t inStringCarry = 0; // All ones while a string continues across blocks
+        int depth = 0;
+        bool expectKey = false;
+        size_t keyStart = string_view::npos;
+        string_view key;
+        int found = 0;
+
+        for (size_t base = 0; base < record.size(); base += 64) {
+            const char* block = data + base;
+            if (record.size() - base < 64) {
+                memset(padded, ' ', sizeof(padded));
+                memcpy(padded, block, record.size() - base);
+                block = padded;
+            }
+
+            BlockMasks masks = classify(block);
+            uint64_t quotes = masks.quote & ~escapedChars(masks.backslash, escapeCarry);
+            uint64_t inString = prefixXor(quotes) ^ inStringCarry;
+            inStringCarry = (uint64_t)((int64_t)inString >> 63);
+
+            uint64_t events = ((masks.open | masks.close | masks.colon | masks.comma) & ~inString) | quotes;
+            while (events) {
+                int bit = __builtin_ctzll(events);
+                events &= events - 1;
+                size_t at = base + bit;
+
+                switch (block[bit]) {
+                case '"':
+                    if ((inString >> bit) & 1) { // Opening quote
+                        if (depth == 1 && expectKey) keyStart = at + 1;
+                    } else if (keyStart != string_view::npos) {
+                        key = record.substr(keyStart, at - keyStart);
+                        keyStart = string_view::npos;
+                        expectKey = false;
+                    }
+                    break;
+                case ':':
+                    if (depth != 1) break;
+                    if (key == "id") {
+                        if (!parseString(data + at + 1, end, id)) return false;
+                        found |= ID;
+                    } else if (key == "created_utc") {
+                        if (!parseInteger(data + at + 1, end, createdUtc)) return false;
+                        found |= CREATED;
+                    } else if (key == "score") {
+                        if (!parseInteger(data + at + 1, end, score)) return false;
+                        found |= SCORE;
+                    }
+                    if (found == ALL) return true;
+                    key = string_view();
+                    break;
+                case ',':
+                    if (depth == 1) expectKey = true;
+                    break;
+                case '{':
+                case '[':
+                    depth++;
+                    if (depth == 1) expectKey = block[bit] == '{';
+                    break;
+                default: // '}' or ']'
+                    depth--;
+                    if (depth == 0) return false; // Record closed without all three
+                    break;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+#endif // JSON_FIELD_SCANNER_H
@@ -26,6 +26,25 @@ public:
         showMainMenu();
     }
 
+    ////////////////////////////////////////////
+    /////////// DISPLAY FORMATTING /////////////
+    ////////////////////////////////////////////
+
+    // The trees hand back PostViews; text is only built here, for display
+
+    // "id (TS: t, Score: s)" - entry of a post list
+    static string formatPost(const PostView& post) {
+        return string(post.postId) + " (TS: " + to_string(post.timestamp) +
+               ", Score: " + to_string(post.score) + ")";
+    }
+
+    // "id (Score: s, Timestamp: t)" - a single highlighted post
+    static string formatPopular(const optional<PostView>& post) {
+        if (!post) return "No posts found";
+        return string(post->postId) + " (Score: " + to_string(post->score) +
+               ", Timestamp: " + to_string(post->timestamp) + ")";
+    }
+
 private:
 
     ////////////////////////////////////////////
@@ -86,6 +105,7 @@ private:
             cout << "5. 🗑️  Deletion Performance" << endl;
             cout << "6. 📈 Query Performance" << endl;
             cout << "7. 🏆 Complete Analysis" << endl;
+            cout << "8. 🧵 Parallel CSV Loading (1 to all cores)" << endl;
             cout << "0. ↩️  Back to Main Menu" << endl;
             cout << string(60, '=') << endl;
             cout << "Enter your choice (0-8): ";
@@ -114,6 +134,9 @@ private:
                 case 7:
                     analysis.runFinalComprehensiveAnalysis();
                     break;
+                case 8:
+                    analysis.testParallelCSVLoading(csv_path, timeLimit);
+                    break;
                 case 0:
                     cout << "Returning to main menu..." << endl;
                     break;
@@ -134,6 +157,8 @@ private:
         int choice;
         BinarySearchTree bst;
         Treap treap;
+        AVLTree avl;
+        BPlusTree bplus;
         
         do {
             cout << "\n" << string(60, '=') << endl;
@@ -146,33 +171,37 @@ private:
             cout << "5. 📊 Show Most Popular" << endl;
             cout << "6. ⏰ Show Most Recent" << endl;
             cout << "7. 🌳 Print Tree Structures" << endl;
+            cout << "8. 🕒 Show Posts in Time Range" << endl;
             cout << "0. ↩️  Back to Main Menu" << endl;
             cout << string(60, '=') << endl;
-            cout << "Enter your choice (0-7): ";
+            cout << "Enter your choice (0-8): ";
             
             cin >> choice;
             
             switch(choice) {
                 case 1:
-                    addPostManually(bst, treap);
+                    addPostManually(bst, treap, avl, bplus);
                     break;
                 case 2:
-                    removePostManually(bst, treap);
+                    removePostManually(bst, treap, avl, bplus);
                     break;
                 case 3:
-                    likePostManually(bst, treap);
+                    likePostManually(bst, treap, avl, bplus);
                     break;
                 case 4:
-                    searchPostManually(bst, treap);
+                    searchPostManually(bst, treap, avl, bplus);
                     break;
                 case 5:
-                    showMostPopular(bst, treap);
+                    showMostPopular(bst, treap, avl, bplus);
                     break;
                 case 6: 
-                    showMostRecent(bst, treap);
+                    showMostRecent(bst, treap, avl, bplus);
                     break;
                 case 7: 
-                    printTreeStructure(bst, treap);
+                    printTreeStructure(bst, treap, avl, bplus);
+                    break;
+                case 8:
+                    showTimeRange(bst, treap, avl, bplus);
                     break;
                 case 0:
                     cout << "Returning to main menu..." << endl;
@@ -188,7 +217,7 @@ private:
 
     /// Add post
     
-    void addPostManually(BinarySearchTree& bst, Treap& treap) {
+    void addPostManually(BinarySearchTree& bst, Treap& treap, AVLTree& avl, BPlusTree& bplus) {
         string id;
         long long timestamp;
         int score;
@@ -203,13 +232,15 @@ private:
 
         bst.addPost(id, timestamp, score);
         treap.addPost(id, timestamp, score);
+        avl.addPost(id, timestamp, score);
+        bplus.addPost(id, timestamp, score);
         
-        cout << "✅ Post added to both BST and Treap!" << endl;
+        cout << "✅ Post added to BST, Treap, AVL and B+ tree!" << endl;
     }
 
     /// Remove post
 
-    void removePostManually(BinarySearchTree& bst, Treap& treap) {
+    void removePostManually(BinarySearchTree& bst, Treap& treap, AVLTree& avl, BPlusTree& bplus) {
         string id;
         cout << "\n🗑️ REMOVE POST" << endl;
         cout << "Enter Post ID to remove: ";
@@ -217,13 +248,15 @@ private:
         
         bst.deletePost(id);
         treap.deletePost(id);
+        avl.deletePost(id);
+        bplus.deletePost(id);
         
-        cout << "✅ Post removed from both structures!" << endl;
+        cout << "✅ Post removed from all structures!" << endl;
     }
 
     /// Like post
 
-    void likePostManually(BinarySearchTree& bst, Treap& treap) {
+    void likePostManually(BinarySearchTree& bst, Treap& treap, AVLTree& avl, BPlusTree& bplus) {
         string id;
         cout << "\n❤️ LIKE POST" << endl;
         cout << "Enter Post ID to like: ";
@@ -231,13 +264,15 @@ private:
         
         bst.likePost(id);
         treap.likePost(id);
+        avl.likePost(id);
+        bplus.likePost(id);
         
-        cout << "✅ Post liked in both structures!" << endl;
+        cout << "✅ Post liked in all structures!" << endl;
     }
 
     /// Search post
 
-    void searchPostManually(BinarySearchTree& bst, Treap& treap) {
+    void searchPostManually(BinarySearchTree& bst, Treap& treap, AVLTree& avl, BPlusTree& bplus) {
         string id;
         cout << "\n🔍 SEARCH POST" << endl;
         cout << "Enter Post ID to search: ";
@@ -245,45 +280,91 @@ private:
         
         treap.printPostById(id);
         bst.printPostById(id);
+        avl.printPostById(id);
+        bplus.printPostById(id);
     }
 
     /// Show most popular post
 
-    void showMostPopular(BinarySearchTree& bst, Treap& treap) {
+    void showMostPopular(BinarySearchTree& bst, Treap& treap, AVLTree& avl, BPlusTree& bplus) {
         cout << "\n📊 MOST POPULAR POSTS" << endl;
-        cout << "BST: " << bst.getMostPopular() << endl;
-        cout << "Treap: " << treap.getMostPopular() << endl;
+        cout << "BST: " << formatPopular(bst.getMostPopular()) << endl;
+        cout << "Treap: " << formatPopular(treap.getMostPopular()) << endl;
+        cout << "AVL: " << formatPopular(avl.getMostPopular()) << endl;
+        cout << "B+: " << formatPopular(bplus.getMostPopular()) << endl;
     }
 
     /// Show most recent posts
 
-    void showMostRecent(BinarySearchTree& bst, Treap& treap) {
+    void showMostRecent(BinarySearchTree& bst, Treap& treap, AVLTree& avl, BPlusTree& bplus) {
         int k;
         cout << "\n⏰ MOST RECENT POSTS" << endl;
         cout << "How many recent posts? ";
         cin >> k;
         
-        vector<string> bst_most = bst.getMostRecent(k);
-        vector<string> treap_most = treap.getMostRecent(k);
+        vector<PostView> recent(max(k, 0));
         
-        for(const string& postId : bst_most) {
-            cout << "BST: " << postId << endl;
+        size_t found = bst.getMostRecent(k, recent.data());
+        for (size_t i = 0; i < found; i++) {
+            cout << "BST: " << formatPost(recent[i]) << endl;
         }
-        for(const string& postId : treap_most) {
-            cout << "Treap: " << postId << endl;
+        found = treap.getMostRecent(k, recent.data());
+        for (size_t i = 0; i < found; i++) {
+            cout << "Treap: " << formatPost(recent[i]) << endl;
         }
+        found = avl.getMostRecent(k, recent.data());
+        for (size_t i = 0; i < found; i++) {
+            cout << "AVL: " << formatPost(recent[i]) << endl;
+        }
+        found = bplus.getMostRecent(k, recent.data());
+        for (size_t i = 0; i < found; i++) {
+            cout << "B+: " << formatPost(recent[i]) << endl;
+        }
+
+    }
+
+    /// One line per post of a range query, oldest first
 
+    template <typename Range>
+    void printRange(const string& label, const Range& range) {
+        for (const auto& post : range) {
+            cout << label << ": " << formatPost(PostView{post.postId, post.timestamp, post.score}) << endl;
+        }
+    }
+
+    /// Show posts in a time window
+
+    void showTimeRange(BinarySearchTree& bst, Treap& treap, AVLTree& avl, BPlusTree& bplus) {
+        long long from, to;
+        cout << "\n🕒 POSTS IN TIME RANGE" << endl;
+        cout << "From timestamp: ";
+        cin >> from;
+        cout << "To timestamp: ";
+        cin >> to;
+
+        printRange("BST", bst.rangeQuery(from, to));
+        printRange("Treap", treap.rangeQuery(from, to));
+        printRange("AVL", avl.rangeQuery(from, to));
+        printRange("B+", bplus.rangeQuery(from, to));
+        cout << "Most popular in range (BST): " << formatPopular(bst.getMostPopularInRange(from, to)) << endl;
+        cout << "Most popular in range (AVL): " << formatPopular(avl.getMostPopularInRange(from, to)) << endl;
     }
 
     /// Print tree structures
 
-    void printTreeStructure(BinarySearchTree& bst, Treap& treap) {
+    void printTreeStructure(BinarySearchTree& bst, Treap& treap, AVLTree& avl, BPlusTree& bplus) {
         cout << "\n🌳 TREE STRUCTURES" << endl;
         cout << "BST Structure:" << endl;
         bst.printVerticalStructure();
         cout << endl;
         cout << "Treap Structure:" << endl;
         treap.printTreapStructure();
+        cout << endl;
+        cout << "AVL Structure:" << endl;
+        avl.printVerticalStructure();
+        cout << endl;
+        cout << "B+ Tree Structure:" << endl;
+        bplus.printStructure();
         cout << "--------------------------------------------------\n\n";
     }
 
@@ -0,0 +1,150 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+using namespace std;
+
+// Memory footprint of a tree: process RSS next to what the tree itself holds
+struct MemoryUsage {
+    long long rssMB;      // Peak resident set size of the whole process
+    size_t arenaBytes;    // Slab memory reserved by the node arena
+    size_t liveNodeBytes; // Portion of the arena holding live nodes
+    size_t indexBytes;    // postId hash index table
+};
+
+// Slab allocator owned by a single tree.
+// Nodes are carved out of large slabs instead of one malloc each; deleted
+// nodes go on an intrusive free list and are reused first. release() hands
+// every slab back at once, so teardown is a handful of frees regardless of
+// node count. Not thread-safe - only the owning tree allocates from it.
+template <typename Node>
+class NodeArena {
+private:
+    union Slot {
+        Slot* next; // Free-list link while the slot is unused
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    static constexpr size_t FIRST_SLAB_SLOTS = 256;
+    static constexpr size_t MAX_SLAB_SLOTS = 65536;
+
+    vector<Slot*> slabs;
+    size_t slabSlots;    // Capacity of the newest slab
+    size_t slabUsed;     // Slots handed out from the newest slab
+    size_t totalSlots;   // Capacity over all slabs
+    Slot* freeList;
+    size_t liveCount;
+
+    Slot* grab() {
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        if (slabs.empty() || slabUsed == slabSlots) {
+            // Slabs double in size so small trees stay small
+            slabSlots = slabs.empty() ? FIRST_SLAB_SLOTS : min(slabSlots * 2, MAX_SLAB_SLOTS);
+            // Over-aligned nodes (e.g. cache-line B+ tree nodes) keep their alignment
+            slabs.push_back(static_cast<Slot*>(::operator new(slabSlots * sizeof(Slot), align_val_t(alignof(Slot)))));
+            slabUsed = 0;
+            totalSlots += slabSlots;
+        }
+        return &slabs.back()[slabUsed++];
+    }
+
+public:
+    // Slots of destroyed nodes linked up away from the arena (e.g. on a
+    // background thread), spliced onto the free list later in O(1)
+    struct FreeChain {
+        Slot* head = nullptr;
+        Slot* tail = nullptr;
+        size_t count = 0;
+    };
+
+    NodeArena() : slabSlots(0), slabUsed(0), totalSlots(0), freeList(nullptr), liveCount(0) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    ~NodeArena() {
+        release();
+    }
+
+    template <typename... Args>
+    Node* create(Args&&... args) {
+        Slot* slot = grab();
+        Node* node = new (slot->storage) Node(std::forward<Args>(args)...);
+        liveCount++;
+        return node;
+    }
+
+    // Destroy a node and put its slot on the free list
+    void destroy(Node* node) {
+        node->~Node();
+        recycle(node);
+    }
+
+    // Put an already-destroyed node's slot on the free list
+    void recycle(Node* node) {
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = freeList;
+        freeList = slot;
+        liveCount--;
+    }
+
+    // Destroy a node into a FreeChain. Touches only the node and the chain,
+    // so it may run on another thread while the arena keeps serving.
+    static void retire(Node* node, FreeChain& chain) {
+        node->~Node();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = chain.head;
+        chain.head = slot;
+        if (!chain.tail) chain.tail = slot;
+        chain.count++;
+    }
+
+    // Splice a FreeChain onto the free list - O(1)
+    void recycle(FreeChain& chain) {
+        if (!chain.head) return;
+        chain.tail->next = freeList;
+        freeList = chain.head;
+        liveCount -= chain.count;
+        chain = FreeChain();
+    }
+
+    // Hand every slab back at once. Live nodes are NOT destroyed here; a
+    // tree with non-trivially destructible nodes runs their destructors first.
+    void release() {
+        for (Slot* slab : slabs) {
+            ::operator delete(slab, align_val_t(alignof(Slot)));
+        }
+        slabs.clear();
+        slabSlots = slabUsed = totalSlots = 0;
+        freeList = nullptr;
+        liveCount = 0;
+    }
+
+    size_t size() const {
+        return liveCount;
+    }
+
+    size_t reservedBytes() const {
+        return totalSlots * sizeof(Slot);
+    }
+
+    size_t liveBytes() const {
+        return liveCount * sizeof(Slot);
+    }
+
+    static constexpr bool needsDestructor() {
+        return !is_trivially_destructible<Node>::value;
+    }
+};
+
+#endif // NODE_ARENA_H
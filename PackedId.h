@@ -0,0 +1,71 @@
+#ifndef PACKED_ID_H
+#define PACKED_ID_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+using namespace std;
+
+// Reddit post IDs are short base-36 strings ("abc123", optionally with a
+// "t3_" style prefix). Up to 12 characters from [0-9a-z_] pack losslessly
+// into a uint64_t: each character becomes a digit 1..37 of a base-38
+// number, so leading '0's survive the round trip and 0 is never a valid ID.
+// Digits follow ASCII order ('0'-'9', '_', 'a'-'z') and the ID is padded
+// with 0 digits to 12 places, so packed IDs compare like the strings do.
+struct PackedId {
+    static constexpr size_t MAX_LENGTH = 12; // 38^12 < 2^64
+
+    static int digitOf(char c) {
+        if (c >= '0' && c <= '9') return 1 + (c - '0');
+        if (c == '_') return 11;
+        if (c >= 'a' && c <= 'z') return 12 + (c - 'a');
+        return 0;
+    }
+
+    // Pack postId; returns 0 if it is empty, too long or has other characters
+    static uint64_t pack(string_view postId) {
+        if (postId.empty() || postId.size() > MAX_LENGTH) return 0;
+
+        uint64_t packed = 0;
+        for (char c : postId) {
+            int digit = digitOf(c);
+            if (!digit) return 0;
+            packed = packed * 38 + digit;
+        }
+        for (size_t i = postId.size(); i < MAX_LENGTH; i++) {
+            packed *= 38;
+        }
+        return packed;
+    }
+
+    // Back to the original string - only needed for output
+    static string unpack(uint64_t packed) {
+        static const char alphabet[] = "0123456789_abcdefghijklmnopqrstuvwxyz";
+
+        char buffer[MAX_LENGTH];
+        for (size_t i = MAX_LENGTH; i > 0; i--) {
+            buffer[i - 1] = (char)(packed % 38);
+            packed /= 38;
+        }
+        size_t length = 0;
+        while (length < MAX_LENGTH && buffer[length]) {
+            buffer[length] = alphabet[buffer[length] - 1];
+            length++;
+        }
+        return string(buffer, length);
+    }
+
+    // 64-bit finaliser (splitmix64) - spreads packed IDs for hashing and
+    // doubles as a deterministic pseudo-random tie-break priority
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+};
+
+#endif // PACKED_ID_H
@@ -0,0 +1,74 @@
+#ifndef POST_H
+#define POST_H
+
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+// Tree order of a post: (timestamp, postId), see postKeyLess
+using PostKey = pair<long long, string_view>;
+
+// Plain post record used for test data and batch loading, and the payload
+// of every Treap / BinarySearchTree node
+struct Post {
+    string postId;
+    long long timestamp;
+    int score;
+
+    // Views postId, so valid while the post is
+    PostKey sortKey() const { return PostKey(timestamp, postId); }
+};
+
+// Score of a post, for score-driven policies (SubtreeTop, ValuePriority)
+struct PostScore {
+    int operator()(const Post& post) const { return post.score; }
+};
+
+// Read-only view of a post returned by the tree queries. postId points
+// into the tree's own node, so a view is valid until that post is deleted
+// (or the tree cleared); building one never allocates.
+struct PostView {
+    string_view postId;
+    long long timestamp;
+    int score;
+};
+
+// Keep the k highest-scoring posts of an iterable window (nodes with
+// postId, timestamp and score) in out[0, k), highest first. out itself
+// serves as the min-heap of the best k so far - O(m log k) for m posts,
+// no allocation. Returns how many posts were written.
+template <typename Window>
+size_t keepTopKByScore(const Window& window, int k, PostView* out) {
+    auto higher = [](const PostView& a, const PostView& b) { return a.score > b.score; };
+    size_t count = 0;
+    if (k <= 0) return 0;
+
+    for (const auto& post : window) {
+        if (count < (size_t)k) {
+            out[count++] = PostView{post.postId, post.timestamp, post.score};
+            push_heap(out, out + count, higher);
+        } else if (post.score > out[0].score) {
+            pop_heap(out, out + count, higher);
+            out[count - 1] = PostView{post.postId, post.timestamp, post.score};
+            push_heap(out, out + count, higher);
+        }
+    }
+    sort_heap(out, out + count, higher);
+    return count;
+}
+
+// Both trees order posts by the composite key (timestamp, postId). Post IDs
+// are unique, so no two posts share a key: ties on timestamp are broken
+// deterministically and any post can be found by key with one descent.
+inline bool postKeyLess(long long ts1, const string& id1, long long ts2, const string& id2) {
+    return ts1 < ts2 || (ts1 == ts2 && id1 < id2);
+}
+
+inline bool postKeyLess(const Post& a, const Post& b) {
+    return postKeyLess(a.timestamp, a.postId, b.timestamp, b.postId);
+}
+
+#endif // POST_H
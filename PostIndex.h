@@ -0,0 +1,138 @@
+#ifndef POST_INDEX_H
+#define POST_INDEX_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Secondary index from postId to tree node.
+// Open addressing with linear probing and backward-shift deletion, so there
+// are no tombstones and probe sequences stay short under heavy delete traffic.
+// The key is read straight from node->postId, so ids are never stored twice.
+template <typename Node>
+class PostIndex {
+private:
+    struct Slot {
+        uint64_t hash; // Cached hash of node->postId (0 = empty slot)
+        Node* node;
+    };
+
+    vector<Slot> slots;
+    size_t count;
+    size_t mask;
+
+    static const size_t INITIAL_CAPACITY = 16;
+
+    // FNV-1a, remapped so that 0 can mark an empty slot
+    static uint64_t hashId(const string& postId) {
+        uint64_t h = 1469598103934665603ULL;
+        for (unsigned char c : postId) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        return h ? h : 1;
+    }
+
+    // Locate the slot holding postId, or the empty slot where it would go
+    size_t probe(const string& postId, uint64_t h) const {
+        size_t i = h & mask;
+        while (slots[i].hash) {
+            if (slots[i].hash == h && slots[i].node->postId == postId) {
+                return i;
+            }
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash(size_t newCapacity) {
+        vector<Slot> old;
+        old.swap(slots);
+        slots.assign(newCapacity, Slot{0, nullptr});
+        mask = newCapacity - 1;
+
+        for (const Slot& s : old) {
+            if (!s.hash) continue;
+            size_t i = s.hash & mask;
+            while (slots[i].hash) i = (i + 1) & mask;
+            slots[i] = s;
+        }
+    }
+
+public:
+    PostIndex() : count(0), mask(INITIAL_CAPACITY - 1) {
+        slots.assign(INITIAL_CAPACITY, Slot{0, nullptr});
+    }
+
+    // O(1) expected lookup
+    Node* find(const string& postId) const {
+        uint64_t h = hashId(postId);
+        const Slot& s = slots[probe(postId, h)];
+        return s.hash ? s.node : nullptr;
+    }
+
+    // Register a node; returns false if its postId is already indexed
+    bool insert(Node* node) {
+        // Keep load factor below 0.7
+        if ((count + 1) * 10 > slots.size() * 7) {
+            rehash(slots.size() * 2);
+        }
+
+        uint64_t h = hashId(node->postId);
+        size_t i = probe(node->postId, h);
+        if (slots[i].hash) return false;
+
+        slots[i] = Slot{h, node};
+        count++;
+        return true;
+    }
+
+    // Remove postId from the index; returns false if it was not present
+    bool erase(const string& postId) {
+        uint64_t h = hashId(postId);
+        size_t i = probe(postId, h);
+        if (!slots[i].hash) return false;
+
+        // Backward-shift: pull later entries of the cluster into the hole
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!slots[j].hash) break;
+            size_t home = slots[j].hash & mask;
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i] = Slot{0, nullptr};
+        count--;
+        return true;
+    }
+
+    // Pre-size the table for n entries (avoids rehashing during bulk loads)
+    void reserve(size_t n) {
+        size_t capacity = slots.size();
+        while (n * 10 > capacity * 7) capacity *= 2;
+        if (capacity != slots.size()) rehash(capacity);
+    }
+
+    void clear() {
+        slots.assign(INITIAL_CAPACITY, Slot{0, nullptr});
+        mask = INITIAL_CAPACITY - 1;
+        count = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // Bytes held by the slot table
+    size_t memoryBytes() const {
+        return slots.capacity() * sizeof(Slot);
+    }
+};
+
+#endif // POST_INDEX_H
@@ -0,0 +1,992 @@
+#ifndef POST_LOADER_H
+#define POST_LOADER_H
+
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <charconv>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+// In-process zstd decoding when libzstd is available (link with -lzstd);
+// otherwise the compressed readers fall back to a `zstd -dc` child process
+#if defined(__has_include)
+#if __has_include(<zstd.h>)
+#include <zstd.h>
+#define POST_LOADER_HAS_LIBZSTD 1
+#endif
+#endif
+#ifndef POST_LOADER_HAS_LIBZSTD
+#define POST_LOADER_HAS_LIBZSTD 0
+#endif
+
+#include "Post.h"
+#include "IngestPipeline.h"
+#include "JsonFieldScanner.h"
+
+using namespace std;
+
+// Outcome of one pass over a dataset file
+struct LoadStats {
+    long long posts = 0;    // Records handed to the sink
+    double seconds = 0.0;   // Wall time of the pass
+    bool timedOut = false;  // Stopped at the time limit before end of file
+    bool opened = true;     // False if the file or pipe could not be opened
+};
+
+// Outcome of a parallel CSV pass (readCSVParallel) and the bulk build after it
+struct ParallelLoadStats : LoadStats {
+    int threads = 1;
+    size_t ranges = 0;         // Newline-aligned byte ranges the file was cut into
+    double parseSeconds = 0.0; // Ranges parsed and sorted
+    double mergeSeconds = 0.0; // Sorted ranges merged into one run
+    double buildSeconds = 0.0; // Filled in by the tree's bulk build
+};
+
+// Read-only view of a whole file through mmap. The pages are mapped
+// private and marked sequential so the kernel reads ahead aggressively and
+// drops pages behind the scan; nothing is copied into user buffers.
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+
+public:
+    explicit MappedFile(const string& filename) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat info;
+        if (fstat(fd, &info) == 0) {
+            length = (size_t)info.st_size;
+            if (length == 0) {
+                opened = true; // Nothing to map
+            } else {
+                void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    madvise(mapped, length, MADV_SEQUENTIAL);
+                    bytes = (const char*)mapped;
+                    opened = true;
+                }
+            }
+        }
+        close(fd); // The mapping keeps the file alive
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (bytes) munmap((void*)bytes, length);
+    }
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+// Tuning of the compressed readers
+struct ZstdOptions {
+    int windowLogMax = 31;        // Largest window (log2 bytes) accepted; the Pushshift dumps use --long=31
+    size_t outputBytes = 1 << 20; // Decompressed bytes per chunk handed to the parsers
+};
+
+#if POST_LOADER_HAS_LIBZSTD
+// Streaming libzstd decoder over compressed bytes in memory (a mapped
+// file, or one frame of it). read() decompresses straight into the
+// caller's buffer - the pipeline's chunk - so decoded bytes are written
+// once and parsed in place. Concatenated frames are decoded back to back.
+// One decoder can be pointed at successive inputs with reset().
+class ZstdMemoryStream {
+private:
+    ZSTD_DCtx* dctx;
+    ZSTD_inBuffer in{nullptr, 0, 0};
+    bool failed = false;
+    size_t frameRemaining = 0; // Last decoder hint: 0 once a frame is complete
+
+public:
+    ZstdMemoryStream(const char* data, size_t size, int windowLogMax) : dctx(ZSTD_createDCtx()) {
+        if (!dctx) throw bad_alloc();
+        ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, windowLogMax);
+        reset(data, size);
+    }
+
+    ZstdMemoryStream(const ZstdMemoryStream&) = delete;
+    ZstdMemoryStream& operator=(const ZstdMemoryStream&) = delete;
+
+    ~ZstdMemoryStream() { ZSTD_freeDCtx(dctx); }
+
+    void reset(const char* data, size_t size) {
+        ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+        in = ZSTD_inBuffer{data, size, 0};
+        failed = false;
+        frameRemaining = 0;
+    }
+
+    // Decoded all the input without errors or a truncated last frame
+    bool completed() const { return !failed && in.pos == in.size && frameRemaining == 0; }
+
+    // Decompress up to capacity bytes into buffer. Returns the number
+    // written; 0 means end of data (or a decoding error, reported on cerr).
+    size_t read(char* buffer, size_t capacity) {
+        ZSTD_outBuffer out{buffer, capacity, 0};
+        while (out.pos < out.size && !failed) {
+            size_t outBefore = out.pos;
+            size_t inBefore = in.pos;
+            size_t result = ZSTD_decompressStream(dctx, &out, &in);
+            if (ZSTD_isError(result)) {
+                cerr << "\nzstd: " << ZSTD_getErrorName(result) << endl;
+                failed = true;
+                break;
+            }
+
+            if (out.pos == outBefore && in.pos == inBefore) break; // Input gone and nothing buffered
+            frameRemaining = result;
+        }
+        return out.pos;
+    }
+};
+
+// Where the zstd frames of a mapped file start and end. Taken from the
+// seek table when the file is in the zstd seekable format; otherwise found
+// one frame at a time by walking block headers (ZSTD_findFrameCompressedSize),
+// so indexing keeps pace with decoding instead of reading the whole file up
+// front. A frame too large to walk cheaply ends the index: the rest of the
+// file becomes one last span, decoded as a stream.
+class ZstdFrameIndex {
+public:
+    struct Span {
+        size_t offset;
+        size_t size;
+    };
+
+private:
+    static constexpr size_t MAX_WALKED_FRAME = 256u << 20;   // Compressed bytes
+    static constexpr uint32_t SEEK_TABLE_MAGIC = 0x8F92EAB1; // Seekable format footer
+    static constexpr uint32_t SEEK_TABLE_SKIPPABLE = 0x184D2A5E;
+
+    const unsigned char* data;
+    size_t size;
+    vector<Span> table; // From the seek table, if there is one
+    size_t nextEntry = 0;
+    size_t offset = 0;  // Walking position otherwise
+    size_t found = 0;
+    bool multiple = false;
+
+    static uint32_t readLE32(const unsigned char* p) {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    bool isSkippable(size_t at) const {
+        return size - at >= 8 && (readLE32(data + at) & ZSTD_MAGIC_SKIPPABLE_MASK) == ZSTD_MAGIC_SKIPPABLE_START;
+    }
+
+    size_t skipSkippable(size_t at) const {
+        while (isSkippable(at)) {
+            size_t frameBytes = 8 + (size_t)readLE32(data + at + 4);
+            at = frameBytes > size - at ? size : at + frameBytes;
+        }
+        return at;
+    }
+
+    // Compressed size of the data frame at `at`, or the rest of the file
+    // when it is too large to walk (or damaged)
+    size_t frameSizeAt(size_t at) const {
+        size_t walked = ZSTD_findFrameCompressedSize(data + at, min(size - at, MAX_WALKED_FRAME));
+        return ZSTD_isError(walked) ? size - at : walked;
+    }
+
+    // Footer: frame count (4 bytes), descriptor (1), magic (4), after one
+    // (compressed, decompressed[, checksum]) entry per frame, all inside a
+    // skippable frame at the end of the file
+    bool readSeekTable() {
+        if (size < 17 || readLE32(data + size - 4) != SEEK_TABLE_MAGIC) return false;
+        size_t frameCount = readLE32(data + size - 9);
+        size_t entryBytes = (data[size - 5] & 0x80) ? 12 : 8;
+        size_t tableBytes = frameCount * entryBytes + 9;
+        if (tableBytes + 8 > size) return false;
+
+        size_t tableStart = size - tableBytes;
+        size_t skippableStart = tableStart - 8;
+        if (readLE32(data + skippableStart) != SEEK_TABLE_SKIPPABLE || readLE32(data + skippableStart + 4) != tableBytes) {
+            return false;
+        }
+
+        vector<Span> spans;
+        size_t at = 0;
+        for (size_t f = 0; f < frameCount; f++) {
+            size_t compressed = readLE32(data + tableStart + f * entryBytes);
+            if (compressed > skippableStart - at) return false;
+            spans.push_back(Span{at, compressed});
+            at += compressed;
+        }
+        if (at != skippableStart) return false;
+
+        table.swap(spans);
+        return true;
+    }
+
+public:
+    ZstdFrameIndex(const char* bytes, size_t length) : data((const unsigned char*)bytes), size(length) {
+        if (readSeekTable()) {
+            multiple = table.size() > 1;
+        } else if (size > 0) {
+            size_t first = skipSkippable(0);
+            multiple = first < size && skipSkippable(first + frameSizeAt(first)) < size;
+        }
+    }
+
+    const char* bytes() const { return (const char*)data; }
+
+    // Worth decoding a frame per thread
+    bool multiFrame() const { return multiple; }
+    bool fromSeekTable() const { return !table.empty(); }
+    size_t framesFound() const { return found; }
+
+    // The next frame in file order; false after the last. Not thread-safe.
+    bool next(Span& span) {
+        if (!table.empty()) {
+            if (nextEntry == table.size()) return false;
+            span = table[nextEntry++];
+        } else {
+            offset = skipSkippable(offset);
+            if (offset >= size) return false;
+            span = Span{offset, frameSizeAt(offset)};
+            offset += span.size;
+        }
+        found++;
+        return true;
+    }
+};
+#endif
+
+// Dataset readers shared by the tree engines. Each reader parses posts and
+// hands them to sink(string_view id, timestamp, score), stopping after
+// timeLimit seconds; the engine decides whether a post is inserted or staged
+// for a bulk build. The id view is only valid for the duration of the call.
+// Progress lines are prefixed with tag ("[AVL]", ...).
+class PostLoader {
+private:
+    static constexpr size_t CHUNK_QUEUE = 16;      // Chunks buffered ahead of the parsers
+    static constexpr size_t BATCH_QUEUE = 64;      // Parsed batches buffered ahead of insertion
+    static constexpr size_t RANGES_PER_THREAD = 4; // CSV ranges are claimed one at a time, so a slow one does not stall the rest
+    static constexpr int STOP_CHECK_ROWS = 4096;   // Rows parsed (or posts inserted) between time-limit checks
+
+    static double secondsSince(chrono::high_resolution_clock::time_point start) {
+        return chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    }
+
+    static void printProgress(const string& tag, long long posts, double elapsedSec, double timeLimit) {
+        double rate = elapsedSec > 0 ? posts / elapsedSec : 0.0;
+        cout << "\r" << tag << " Posts: " << posts << " | Time: " << fixed << setprecision(2)
+             << elapsedSec << "s | Rate: " << fixed << setprecision(0) << rate << " posts/s";
+        if (isfinite(timeLimit)) cout << " | Remaining: " << (int)(timeLimit - elapsedSec) << "s";
+        cout << flush;
+    }
+
+public:
+    // Parse threads of the compressed readers (0 = all cores but two, one
+    // each for decompression and insertion)
+    static inline int parseWorkers = 0;
+
+    // Window limit and buffer sizes of the compressed readers
+    static inline ZstdOptions zstdOptions;
+
+    // Frame decoding threads for multi-frame zstd files (0 = half the cores)
+    static inline int decodeWorkers = 0;
+
+    // Full dataset size the 30-second samples are projected onto
+    static constexpr double FULL_DATASET_POSTS = 134000000.0;
+
+    // Seconds a full load would take at the rate of this pass
+    static double estimateFullLoad(const LoadStats& stats) {
+        if (stats.posts == 0 || stats.seconds <= 0) return 0.0;
+        return FULL_DATASET_POSTS / (stats.posts / stats.seconds);
+    }
+
+    // Pull the top-level id, created_utc and score out of one JSON record
+    // (single pass, see JsonFieldScanner.h). Returns false if a field is
+    // missing or not of the right kind.
+    static bool parseJSONPost(string_view line, string_view& id, long long& timestamp, int& score) {
+        return JsonFieldScanner::scan(line, id, timestamp, score);
+    }
+
+    // Parse one "id,timestamp,score" row in place. Returns false for
+    // malformed rows (missing fields, non-numeric or trailing characters).
+    static bool parseCSVRow(const char* begin, const char* end, string_view& id, long long& timestamp, int& score) {
+        if (end > begin && end[-1] == '\r') end--;
+
+        const char* comma1 = (const char*)memchr(begin, ',', end - begin);
+        if (!comma1 || comma1 == begin) return false;
+        const char* comma2 = (const char*)memchr(comma1 + 1, ',', end - comma1 - 1);
+        if (!comma2) return false;
+
+        auto [tsEnd, tsError] = from_chars(comma1 + 1, comma2, timestamp);
+        if (tsError != errc() || tsEnd != comma2) return false;
+        auto [scoreEnd, scoreError] = from_chars(comma2 + 1, end, score);
+        if (scoreError != errc() || scoreEnd != end) return false;
+
+        id = string_view(begin, comma1 - begin);
+        return true;
+    }
+
+    // "id,timestamp,score" rows after a header line, scanned straight out of
+    // the memory-mapped file: no per-row strings, no exceptions
+    template <typename Sink>
+    static LoadStats readCSV(const string& filename, const string& tag, double timeLimit, Sink&& sink) {
+        LoadStats stats;
+        MappedFile file(filename);
+        if (!file.isOpen()) {
+            cerr << "Unable to open CSV file: " << filename << endl;
+            stats.opened = false;
+            return stats;
+        }
+
+        auto startTime = chrono::high_resolution_clock::now();
+        const char* cursor = file.data();
+        const char* fileEnd = cursor + file.size();
+        string_view id;
+        long long timestamp;
+        int score;
+
+        // Skip header line if exists
+        if (cursor) {
+            const char* eol = (const char*)memchr(cursor, '\n', fileEnd - cursor);
+            cursor = eol ? eol + 1 : fileEnd;
+        }
+
+        try {
+            int rows = 0;
+            while (cursor < fileEnd) {
+                const char* eol = (const char*)memchr(cursor, '\n', fileEnd - cursor);
+                const char* lineEnd = eol ? eol : fileEnd;
+                if (parseCSVRow(cursor, lineEnd, id, timestamp, score)) {
+                    sink(id, timestamp, score);
+                    stats.posts++;
+                }
+                cursor = lineEnd + 1;
+
+                if (++rows == STOP_CHECK_ROWS) {
+                    rows = 0;
+                    double elapsedSec = secondsSince(startTime);
+                    if (elapsedSec >= timeLimit) {
+                        stats.timedOut = true;
+                        break;
+                    }
+                    printProgress(tag, stats.posts, elapsedSec, timeLimit);
+                }
+            }
+        } catch (const bad_alloc&) {
+            cerr << "\n" << tag << " CRITICAL MEMORY ERROR" << endl;
+            cerr << "Failed after " << stats.posts << " posts" << endl;
+        }
+
+        stats.seconds = secondsSince(startTime);
+        return stats;
+    }
+
+    // Split [begin, end) into about count ranges of similar size. Each cut
+    // is moved forward to just past a newline, so every range starts at a
+    // row and no row is split between two ranges.
+    static vector<pair<const char*, const char*>> splitAtNewlines(const char* begin, const char* end, size_t count) {
+        vector<pair<const char*, const char*>> ranges;
+        size_t step = max<size_t>(1, (size_t)(end - begin) / max<size_t>(count, 1));
+        const char* cursor = begin;
+        while (cursor < end) {
+            const char* cut = end;
+            if ((size_t)(end - cursor) > step) {
+                const char* eol = (const char*)memchr(cursor + step, '\n', end - cursor - step);
+                cut = eol ? eol + 1 : end;
+            }
+            ranges.push_back({cursor, cut});
+            cursor = cut;
+        }
+        return ranges;
+    }
+
+    // Run work(0) .. work(count - 1) at once, work(0) on the calling thread
+    template <typename Work>
+    static void onThreads(int count, Work&& work) {
+        vector<thread> helpers;
+        for (int i = 1; i < count; i++) {
+            helpers.emplace_back([&work, i] { work(i); });
+        }
+        work(0);
+        for (thread& helper : helpers) helper.join();
+    }
+
+    // Parse the whole CSV on threads cores (0 = all of them) into posts,
+    // sorted by (timestamp, postId) and ready for buildFromSorted().
+    //
+    // The mapped file is cut into newline-aligned byte ranges, a few per
+    // thread. Workers claim ranges one at a time, parse each into its own
+    // Post buffer and sort it; the sorted buffers are then merged pairwise,
+    // each round's merges spread over the threads. Merging is stable and
+    // ranges keep file order, so duplicate keys come out in file order as
+    // with readCSV. Stops after timeLimit seconds, keeping the rows parsed
+    // so far from every range.
+    static ParallelLoadStats readCSVParallel(const string& filename, const string& tag, double timeLimit,
+                                             int threads, vector<Post>& posts) {
+        ParallelLoadStats stats;
+        posts.clear();
+        MappedFile file(filename);
+        if (!file.isOpen()) {
+            cerr << "Unable to open CSV file: " << filename << endl;
+            stats.opened = false;
+            return stats;
+        }
+
+        auto startTime = chrono::high_resolution_clock::now();
+        const char* body = file.data();
+        const char* fileEnd = body + file.size();
+
+        // Skip header line if exists
+        if (body) {
+            const char* eol = (const char*)memchr(body, '\n', fileEnd - body);
+            body = eol ? eol + 1 : fileEnd;
+        }
+
+        stats.threads = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+        auto ranges = splitAtNewlines(body, fileEnd, (size_t)stats.threads * RANGES_PER_THREAD);
+        stats.ranges = ranges.size();
+        vector<vector<Post>> runs(ranges.size());
+
+        atomic<size_t> nextRange(0);
+        atomic<long long> parsed(0);
+        atomic<bool> stop(false);
+        atomic<bool> timedOut(false);
+        atomic<bool> outOfMemory(false);
+        auto byKey = [](const Post& a, const Post& b) { return postKeyLess(a, b); };
+
+        // Parse and sort ranges
+        onThreads(stats.threads, [&](int worker) {
+            string_view id;
+            long long timestamp;
+            int score;
+            try {
+                for (size_t r = nextRange++; r < ranges.size() && !stop.load(memory_order_relaxed); r = nextRange++) {
+                    const char* cursor = ranges[r].first;
+                    const char* rangeEnd = ranges[r].second;
+                    vector<Post>& run = runs[r];
+                    run.reserve((rangeEnd - cursor) / 24); // About the length of one row
+
+                    int rows = 0;
+                    size_t counted = 0; // Posts of this range already added to parsed
+                    while (cursor < rangeEnd) {
+                        const char* eol = (const char*)memchr(cursor, '\n', rangeEnd - cursor);
+                        const char* lineEnd = eol ? eol : rangeEnd;
+                        if (parseCSVRow(cursor, lineEnd, id, timestamp, score)) {
+                            run.push_back(Post{string(id), timestamp, score});
+                        }
+                        cursor = lineEnd + 1;
+
+                        if (++rows == STOP_CHECK_ROWS) {
+                            long long total = parsed.fetch_add(run.size() - counted, memory_order_relaxed) + (run.size() - counted);
+                            counted = run.size();
+                            rows = 0;
+                            double elapsedSec = secondsSince(startTime);
+                            if (elapsedSec >= timeLimit) {
+                                timedOut.store(true);
+                                stop.store(true);
+                            }
+                            if (stop.load(memory_order_relaxed)) break;
+                            if (worker == 0) printProgress(tag, total, elapsedSec, timeLimit);
+                        }
+                    }
+                    parsed.fetch_add(run.size() - counted, memory_order_relaxed);
+                    stable_sort(run.begin(), run.end(), byKey);
+                }
+            } catch (const bad_alloc&) {
+                outOfMemory.store(true);
+                stop.store(true);
+            }
+        });
+        stats.parseSeconds = secondsSince(startTime);
+
+        // Merge sorted ranges pairwise, neighbours only, so file order holds
+        auto mergeStart = chrono::high_resolution_clock::now();
+        try {
+            while (runs.size() > 1 && !outOfMemory.load()) {
+                vector<vector<Post>> merged((runs.size() + 1) / 2);
+                atomic<size_t> nextPair(0);
+                int mergeThreads = (int)min<size_t>((size_t)stats.threads, runs.size() / 2);
+                onThreads(mergeThreads, [&](int) {
+                    try {
+                        for (size_t p = nextPair++; p < merged.size(); p = nextPair++) {
+                            if (2 * p + 1 == runs.size()) {
+                                merged[p] = std::move(runs[2 * p]);
+                                continue;
+                            }
+                            vector<Post>& a = runs[2 * p];
+                            vector<Post>& b = runs[2 * p + 1];
+                            merged[p].reserve(a.size() + b.size());
+                            merge(make_move_iterator(a.begin()), make_move_iterator(a.end()),
+                                  make_move_iterator(b.begin()), make_move_iterator(b.end()),
+                                  back_inserter(merged[p]), byKey);
+                            vector<Post>().swap(a);
+                            vector<Post>().swap(b);
+                        }
+                    } catch (const bad_alloc&) {
+                        outOfMemory.store(true);
+                    }
+                });
+                runs = std::move(merged);
+            }
+            if (!runs.empty() && !outOfMemory.load()) posts = std::move(runs[0]);
+        } catch (const bad_alloc&) {
+            outOfMemory.store(true);
+        }
+        stats.mergeSeconds = secondsSince(mergeStart);
+
+        if (outOfMemory.load()) {
+            cerr << "\n" << tag << " CRITICAL MEMORY ERROR" << endl;
+            cerr << "Failed after " << parsed.load() << " posts" << endl;
+        }
+
+        stats.posts = (long long)posts.size();
+        stats.timedOut = timedOut.load();
+        stats.seconds = secondsSince(startTime);
+        return stats;
+    }
+
+    // Cut a stream of decoded bytes, pulled with read(buffer, capacity)
+    // until it returns 0, into newline-aligned chunks emitted as parts of
+    // one run. With keepEdges the bytes up to the first newline go to head
+    // and those after the last one to tail instead (the record may continue
+    // in a neighbouring zstd frame); otherwise the trailing partial record
+    // is emitted as part of the last chunk. Returns false if the run held no
+    // newline at all (everything went to head).
+    template <typename Source, typename Emit>
+    static bool chunkRecords(Source&& read, uint64_t run, bool keepEdges, string& head, string& tail,
+                             Emit& emit, StageCounters& counters, const atomic<bool>& stop) {
+        string carry;
+        bool atEnd = false;
+        bool seenNewline = !keepEdges;
+        uint32_t part = 0;
+        TextChunk held;
+        bool holding = false;
+
+        while (!atEnd && !stop.load(memory_order_relaxed)) {
+            string chunk = std::move(carry);
+            carry = string();
+            size_t filled = chunk.size();
+            size_t scanFrom = filled;
+            const char* lastNewline = nullptr;
+            chunk.resize(max(zstdOptions.outputBytes, filled * 2));
+
+            // Fill the chunk; if it fills up without a newline the record
+            // is longer than a chunk, so grow it
+            while (!stop.load(memory_order_relaxed)) {
+                size_t got = read(&chunk[filled], chunk.size() - filled);
+                if (got == 0) {
+                    atEnd = true;
+                    break;
+                }
+                filled += got;
+                counters.bytes.fetch_add(got, memory_order_relaxed);
+                if (filled < chunk.size()) continue;
+
+                const char* newline = (const char*)memrchr(chunk.data() + scanFrom, '\n', filled - scanFrom);
+                if (newline) {
+                    lastNewline = newline;
+                    break;
+                }
+                scanFrom = filled;
+                chunk.resize(chunk.size() * 2);
+            }
+            if (stop.load(memory_order_relaxed)) return seenNewline;
+
+            // The partial record after the last newline waits for more bytes
+            if (!atEnd && lastNewline) {
+                size_t keep = lastNewline - chunk.data() + 1;
+                carry.assign(chunk, keep, filled - keep);
+                filled = keep;
+            }
+            chunk.resize(filled);
+
+            size_t begin = 0;
+            if (!seenNewline) {
+                const char* newline = (const char*)memchr(chunk.data(), '\n', chunk.size());
+                if (!newline) {
+                    head.append(chunk); // Only at the end: a run without any newline
+                    continue;
+                }
+                begin = newline - chunk.data() + 1;
+                head.assign(chunk, 0, begin);
+                seenNewline = true;
+            }
+            if (atEnd && keepEdges) {
+                const char* newline = (const char*)memrchr(chunk.data() + begin, '\n', chunk.size() - begin);
+                size_t end = newline ? newline - chunk.data() + 1 : begin;
+                tail.assign(chunk, end, string::npos);
+                chunk.resize(end);
+            }
+
+            // Hold one chunk back so the run's last part can be flagged
+            if (holding) {
+                held.order.lastPart = false;
+                if (!emit(std::move(held))) return seenNewline;
+            }
+            held = TextChunk{ChunkOrder{run, part++, true}, std::move(chunk), begin};
+            holding = true;
+        }
+
+        if (!holding) held = TextChunk{ChunkOrder{run, 0, true}, string(), 0};
+        emit(std::move(held));
+        return seenNewline;
+    }
+
+#if POST_LOADER_HAS_LIBZSTD
+    // Decode the frames of a multi-frame file on pipeline.threads threads.
+    // Frame i's whole records go out as run 2i + 1. A record cut by the
+    // boundary before frame i (the previous frames' tail plus frame i's
+    // head) goes out as run 2i once both sides are decoded, and whatever
+    // follows the last newline of the file as the final run. In-order loads
+    // decode at most a few frames ahead of insertion, which bounds the
+    // batches parked in the insert stage. Returns false if a frame failed
+    // to decode.
+    template <typename Emit>
+    static bool decodeFrames(ZstdFrameIndex& frames, bool inOrder, Emit& emit, StageCounters& counters,
+                             const atomic<bool>& stop, const atomic<uint64_t>& nextRun) {
+        struct Edges {
+            string head;     // Up to and including the first newline
+            string tail;     // After the last newline
+            bool hasNewline = false;
+            bool decoded = false;
+        };
+
+        mutex lock;
+        vector<Edges> edges; // One per frame claimed so far
+        size_t seamCursor = 0; // First frame whose leading seam is not out yet
+        string pending;        // Partial record carried across frames
+        atomic<bool> failed(false);
+        atomic<bool> abandoned(false); // A decoder ran out of memory mid-frame
+        uint64_t window = 2 * counters.threads + 2; // Frames decoded ahead of insertion
+
+        auto worker = [&] {
+            ZstdMemoryStream stream(nullptr, 0, zstdOptions.windowLogMax);
+            while (!stop.load(memory_order_relaxed) && !abandoned.load(memory_order_relaxed)) {
+                ZstdFrameIndex::Span span;
+                size_t index;
+                {
+                    lock_guard<mutex> guard(lock);
+                    if (!frames.next(span)) break;
+                    index = edges.size();
+                    edges.emplace_back();
+                }
+
+                if (inOrder && 2 * index + 1 > nextRun.load(memory_order_relaxed) + 2 * window) {
+                    auto start = chrono::steady_clock::now();
+                    while (!stop.load(memory_order_relaxed) && !abandoned.load(memory_order_relaxed) &&
+                           2 * index + 1 > nextRun.load(memory_order_relaxed) + 2 * window) {
+                        this_thread::sleep_for(chrono::microseconds(100));
+                    }
+                    counters.waitNanos.fetch_add(
+                        chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+                    if (abandoned.load(memory_order_relaxed)) break;
+                }
+
+                stream.reset(frames.bytes() + span.offset, span.size);
+                string head, tail;
+                bool hasNewline = chunkRecords([&stream](char* buffer, size_t capacity) { return stream.read(buffer, capacity); },
+                                               2 * index + 1, true, head, tail, emit, counters, stop);
+                if (stop.load(memory_order_relaxed)) break;
+                if (!stream.completed()) failed.store(true);
+
+                lock_guard<mutex> guard(lock);
+                edges[index] = Edges{std::move(head), std::move(tail), hasNewline, true};
+                while (seamCursor < edges.size() && edges[seamCursor].decoded) {
+                    Edges& frame = edges[seamCursor];
+                    pending += frame.head;
+                    TextChunk seam{ChunkOrder{2 * seamCursor, 0, true}, string(), 0};
+                    if (frame.hasNewline) {
+                        seam.text = std::move(pending);
+                        pending = std::move(frame.tail);
+                    }
+                    frame = Edges{string(), string(), frame.hasNewline, true};
+                    seamCursor++;
+                    if (!emit(std::move(seam))) return;
+                }
+            }
+        };
+
+        vector<thread> decoders;
+        for (int t = 0; t < counters.threads; t++) {
+            decoders.emplace_back([&] {
+                try {
+                    worker();
+                } catch (const bad_alloc&) {
+                    // The seams stall at this frame, so insertion stops
+                    // advancing: the other decoders must not wait on it
+                    failed.store(true);
+                    abandoned.store(true);
+                }
+            });
+        }
+        for (thread& decoder : decoders) decoder.join();
+
+        if (!stop.load(memory_order_relaxed) && seamCursor == edges.size()) {
+            emit(TextChunk{ChunkOrder{2 * edges.size(), 0, true}, std::move(pending), 0});
+        }
+        return !failed.load();
+    }
+#endif
+
+    // Staged loader behind the compressed readers (see IngestPipeline.h).
+    // produce(emit, stop, nextRun) runs on its own thread and feeds decoded
+    // chunks to emit (false once the load is stopping); parse workers turn
+    // chunks into batches; sink runs on the calling thread, so trees need
+    // no locking. With inOrder, batches are put back into file order before
+    // insertion and nextRun is the run insertion waits for, so producers
+    // can bound how far they decode ahead. Stops every stage once timeLimit
+    // seconds have passed.
+    template <typename Produce, typename Sink>
+    static LoadStats runPipeline(Produce&& produce, const string& tag, double timeLimit, bool inOrder,
+                                 Sink&& sink, PipelineStats& pipeline) {
+        LoadStats stats;
+        int cores = (int)thread::hardware_concurrency();
+        int workers = parseWorkers > 0 ? parseWorkers : max(1, cores - pipeline.decompress.threads - 1);
+        pipeline.parse.threads = workers;
+
+        BoundedQueue<TextChunk> chunks(CHUNK_QUEUE);
+        BoundedQueue<PostBatch> batches(BATCH_QUEUE);
+        atomic<bool> stop(false);
+        atomic<uint64_t> nextRun(inOrder ? 0 : UINT64_MAX);
+        atomic<int> activeWorkers(workers);
+        auto startTime = chrono::high_resolution_clock::now();
+
+        // Decompress
+        thread decompressor([&] {
+            auto emit = [&](TextChunk&& chunk) {
+                if (!chunks.push(std::move(chunk), stop, pipeline.decompress.waitNanos)) return false;
+                pipeline.decompress.items.fetch_add(1, memory_order_relaxed);
+                return true;
+            };
+            try {
+                produce(emit, stop, nextRun);
+            } catch (const bad_alloc&) {
+                stop.store(true);
+            }
+            chunks.close();
+        });
+
+        // Parse: one batch of posts per chunk
+        vector<thread> parsers;
+        for (int w = 0; w < workers; w++) {
+            parsers.emplace_back([&] {
+                try {
+                    TextChunk chunk;
+                    string_view id;
+                    long long timestamp;
+                    int score;
+                    while (chunks.pop(chunk, stop, pipeline.parse.waitNanos)) {
+                        PostBatch batch;
+                        batch.order = chunk.order;
+                        long long records = 0;
+                        const char* cursor = chunk.text.data() + chunk.begin;
+                        const char* chunkEnd = chunk.text.data() + chunk.text.size();
+                        while (cursor < chunkEnd) {
+                            const char* eol = (const char*)memchr(cursor, '\n', chunkEnd - cursor);
+                            const char* lineEnd = eol ? eol : chunkEnd;
+                            if (parseJSONPost(string_view(cursor, lineEnd - cursor), id, timestamp, score)) {
+                                batch.add(id, timestamp, score);
+                            }
+                            records++;
+                            cursor = lineEnd + 1;
+                        }
+                        pipeline.parse.items.fetch_add(records, memory_order_relaxed);
+                        pipeline.parse.bytes.fetch_add(chunk.text.size() - chunk.begin, memory_order_relaxed);
+                        if (!batches.push(std::move(batch), stop, pipeline.parse.waitNanos)) break;
+                    }
+                } catch (const bad_alloc&) {
+                    stop.store(true);
+                }
+                if (activeWorkers.fetch_sub(1) == 1) batches.close();
+            });
+        }
+
+        // Insert: the caller's thread, the only one touching the tree
+        auto insertBatch = [&](const PostBatch& batch) {
+            for (const PostBatch::Entry& entry : batch.entries) {
+                sink(batch.idOf(entry), entry.timestamp, entry.score);
+                stats.posts++;
+
+                if (stats.posts % STOP_CHECK_ROWS == 0) {
+                    double elapsedSec = secondsSince(startTime);
+                    if (elapsedSec >= timeLimit) {
+                        stats.timedOut = true;
+                        return;
+                    }
+                    printProgress(tag, stats.posts, elapsedSec, timeLimit);
+                }
+            }
+        };
+
+        try {
+            PostBatch batch;
+            map<ChunkOrder, PostBatch> early; // Arrived ahead of their turn
+            ChunkOrder expected{0, 0, true};
+            while (!stats.timedOut && batches.pop(batch, stop, pipeline.insert.waitNanos)) {
+                if (!inOrder) {
+                    insertBatch(batch);
+                    continue;
+                }
+                early.emplace(batch.order, std::move(batch));
+                while (!stats.timedOut && !early.empty() && early.begin()->first.samePlace(expected)) {
+                    auto next = early.begin();
+                    expected = next->first.next();
+                    insertBatch(next->second);
+                    early.erase(next);
+                    nextRun.store(expected.run, memory_order_relaxed);
+                }
+            }
+        } catch (const bad_alloc&) {
+            cerr << "\n" << tag << " CRITICAL MEMORY ERROR" << endl;
+            cerr << "Failed after " << stats.posts << " posts" << endl;
+        }
+
+        stop.store(true);
+        decompressor.join();
+        for (thread& parser : parsers) parser.join();
+
+        pipeline.insert.items.store(stats.posts);
+        stats.seconds = secondsSince(startTime);
+        pipeline.seconds = stats.seconds;
+        return stats;
+    }
+
+    // Throughput and waiting time of each stage, and which one limited the load
+    static void printPipeline(const string& tag, const PipelineStats& pipeline) {
+        double wall = pipeline.seconds > 0 ? pipeline.seconds : 1e-9;
+        const StageCounters* stages[] = {&pipeline.decompress, &pipeline.parse, &pipeline.insert};
+        const char* names[] = {"decompress", "parse", "insert"};
+
+        size_t bottleneck = 0;
+        for (size_t i = 1; i < 3; i++) {
+            if (stages[i]->waitShare(wall) < stages[bottleneck]->waitShare(wall)) bottleneck = i;
+        }
+
+        cout << "\n" << tag << " Pipeline (" << fixed << setprecision(2) << wall << "s):" << endl;
+        cout << tag << "   decompress: " << setprecision(1) << pipeline.decompress.bytes.load() / 1048576.0 << " MB at "
+             << pipeline.decompress.bytes.load() / 1048576.0 / wall << " MB/s | waiting "
+             << setprecision(0) << 100 * pipeline.decompress.waitShare(wall) << "%" << endl;
+        cout << tag << "   parse x" << pipeline.parse.threads << ": " << pipeline.parse.items.load() << " records at "
+             << pipeline.parse.items.load() / wall << " records/s, " << setprecision(1)
+             << pipeline.parse.bytes.load() / 1048576.0 / wall << " MB/s | waiting "
+             << setprecision(0) << 100 * pipeline.parse.waitShare(wall) << "%" << endl;
+        cout << tag << "   insert: " << pipeline.insert.items.load() << " posts at " << pipeline.insert.items.load() / wall
+             << " posts/s | waiting " << 100 * pipeline.insert.waitShare(wall) << "%" << endl;
+        cout << tag << "   bottleneck: " << names[bottleneck] << endl;
+    }
+
+    // zstd-compressed JSON lines, parsed and inserted through the staged
+    // pipeline, in file order
+    template <typename Sink>
+    static LoadStats readZST(const string& zstFilename, const string& tag, double timeLimit, Sink&& sink) {
+        return readZST(zstFilename, tag, timeLimit, true, sink);
+    }
+
+    // Same; inOrder = false lets posts reach the sink in whatever order
+    // they are parsed, for targets that sort anyway (bulk builds).
+    // With libzstd, files made of several zstd frames are decoded a frame
+    // per thread; single-frame files stream through one decoder.
+    template <typename Sink>
+    static LoadStats readZST(const string& zstFilename, const string& tag, double timeLimit, bool inOrder, Sink&& sink) {
+#if POST_LOADER_HAS_LIBZSTD
+        MappedFile file(zstFilename);
+        if (!file.isOpen()) {
+            cerr << tag << " Unable to open compressed file: " << zstFilename << endl;
+            LoadStats stats;
+            stats.opened = false;
+            return stats;
+        }
+
+        ZstdFrameIndex frames(file.data(), file.size());
+        PipelineStats pipeline;
+        LoadStats stats;
+        bool completed = true;
+
+        if (frames.multiFrame()) {
+            pipeline.decompress.threads = decodeWorkers > 0 ? decodeWorkers : max(1, (int)thread::hardware_concurrency() / 2);
+            stats = runPipeline(
+                [&](auto& emit, const atomic<bool>& stop, const atomic<uint64_t>& nextRun) {
+                    completed = decodeFrames(frames, inOrder, emit, pipeline.decompress, stop, nextRun);
+                },
+                tag, timeLimit, inOrder, sink, pipeline);
+            cout << "\n" << tag << " Decoded " << frames.framesFound() << " zstd frames on "
+                 << pipeline.decompress.threads << " threads" << (frames.fromSeekTable() ? " (seek table)" : "") << flush;
+        } else {
+            ZstdMemoryStream stream(file.data(), file.size(), zstdOptions.windowLogMax);
+            stats = runPipeline(
+                [&](auto& emit, const atomic<bool>& stop, const atomic<uint64_t>&) {
+                    string head, tail;
+                    chunkRecords([&stream](char* buffer, size_t capacity) { return stream.read(buffer, capacity); },
+                                 0, false, head, tail, emit, pipeline.decompress, stop);
+                    completed = stream.completed();
+                },
+                tag, timeLimit, inOrder, sink, pipeline);
+        }
+
+        if (!stats.timedOut && !completed) {
+            cerr << "\n" << tag << " Compressed stream ended early: " << zstFilename << endl;
+        }
+        printPipeline(tag, pipeline);
+        return stats;
+#else
+        return readZSTPipe(zstFilename, tag, timeLimit, inOrder, sink);
+#endif
+    }
+
+    // Same, with a `zstd -dc` child process doing the decompression
+    template <typename Sink>
+    static LoadStats readZSTPipe(const string& zstFilename, const string& tag, double timeLimit, bool inOrder, Sink&& sink) {
+        // popen succeeds even when zstd cannot read the file, so check first
+        if (access(zstFilename.c_str(), R_OK) != 0) {
+            cerr << tag << " Unable to open compressed file: " << zstFilename << endl;
+            LoadStats stats;
+            stats.opened = false;
+            return stats;
+        }
+
+        string cmd = "zstd -dc --long=" + to_string(zstdOptions.windowLogMax) + " '" + zstFilename + "' 2>/dev/null";
+        FILE* f = popen(cmd.c_str(), "r");
+        if (!f) {
+            cerr << tag << " Failed to open pipe" << endl;
+            LoadStats stats;
+            stats.opened = false;
+            return stats;
+        }
+
+        PipelineStats pipeline;
+        LoadStats stats = runPipeline(
+            [&](auto& emit, const atomic<bool>& stop, const atomic<uint64_t>&) {
+                string head, tail;
+                chunkRecords([f](char* buffer, size_t capacity) { return fread(buffer, 1, capacity, f); },
+                             0, false, head, tail, emit, pipeline.decompress, stop);
+            },
+            tag, timeLimit, inOrder, sink, pipeline);
+
+        pclose(f);
+        printPipeline(tag, pipeline);
+        return stats;
+    }
+};
+
+#endif // POST_LOADER_H
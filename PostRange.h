@@ -0,0 +1,133 @@
+#ifndef POST_RANGE_H
+#define POST_RANGE_H
+
+#include <iterator>
+#include <cstddef>
+
+using namespace std;
+
+// Lightweight view over the tree nodes whose timestamps fall in [from, to].
+// Holds only the first and last node of the window; iterators step with
+// parent links (in-order successor / predecessor), so walking k posts is
+// O(k) amortised on top of the O(depth) boundary search, with no copies.
+// Node needs left, right and parent pointers.
+//
+// The view is invalidated by any insert/delete on the tree it came from.
+template <typename Node>
+class PostRange {
+public:
+    static Node* leftmost(Node* node) {
+        while (node && node->left) node = node->left;
+        return node;
+    }
+
+    static Node* rightmost(Node* node) {
+        while (node && node->right) node = node->right;
+        return node;
+    }
+
+    static Node* successor(Node* node) {
+        if (node->right) return leftmost(node->right);
+        while (node->parent && node->parent->right == node) node = node->parent;
+        return node->parent;
+    }
+
+    static Node* predecessor(Node* node) {
+        if (node->left) return rightmost(node->left);
+        while (node->parent && node->parent->left == node) node = node->parent;
+        return node->parent;
+    }
+
+    // Forward (oldest first) or reverse (newest first) iterator
+    template <bool Reverse>
+    class Iterator {
+    private:
+        Node* node;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = Node;
+        using difference_type = ptrdiff_t;
+        using pointer = const Node*;
+        using reference = const Node&;
+
+        explicit Iterator(Node* n = nullptr) : node(n) {}
+
+        reference operator*() const { return *node; }
+        pointer operator->() const { return node; }
+
+        Iterator& operator++() {
+            node = Reverse ? predecessor(node) : successor(node);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+    };
+
+    using iterator = Iterator<false>;
+    using reverse_iterator = Iterator<true>;
+
+    // Range-for adaptor for newest-first traversal
+    struct Reversed {
+        reverse_iterator first, last;
+        reverse_iterator begin() const { return first; }
+        reverse_iterator end() const { return last; }
+    };
+
+private:
+    Node* first; // Oldest node in the window (nullptr if empty)
+    Node* last;  // Newest node in the window (nullptr if empty)
+
+public:
+    // Locate the window boundaries below root - O(depth)
+    PostRange(Node* root, long long from, long long to) : first(nullptr), last(nullptr) {
+        if (from > to) return;
+
+        // First node with timestamp >= from
+        for (Node* node = root; node; ) {
+            if (node->timestamp >= from) {
+                first = node;
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+
+        // Last node with timestamp <= to
+        for (Node* node = root; node; ) {
+            if (node->timestamp <= to) {
+                last = node;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+
+        if (!first || !last || first->timestamp > to) {
+            first = last = nullptr;
+        }
+    }
+
+    bool empty() const {
+        return first == nullptr;
+    }
+
+    iterator begin() const { return iterator(first); }
+    iterator end() const { return iterator(last ? successor(last) : nullptr); }
+
+    reverse_iterator rbegin() const { return reverse_iterator(last); }
+    reverse_iterator rend() const { return reverse_iterator(first ? predecessor(first) : nullptr); }
+
+    Reversed reversed() const {
+        return Reversed{rbegin(), rend()};
+    }
+};
+
+#endif // POST_RANGE_H
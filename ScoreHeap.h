@@ -0,0 +1,87 @@
+#ifndef SCORE_HEAP_H
+#define SCORE_HEAP_H
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Indexed binary max-heap of tree nodes ordered by score.
+// Each node remembers its slot in node->heapPos, so a score change or a
+// removal is O(log n) without searching, and the top is O(1).
+template <typename Node>
+class ScoreHeap {
+private:
+    vector<Node*> heap;
+
+    void place(size_t pos, Node* node) {
+        heap[pos] = node;
+        node->heapPos = pos;
+    }
+
+    void siftUp(size_t pos) {
+        Node* node = heap[pos];
+        while (pos > 0) {
+            size_t parent = (pos - 1) / 2;
+            if (heap[parent]->score >= node->score) break;
+            place(pos, heap[parent]);
+            pos = parent;
+        }
+        place(pos, node);
+    }
+
+    void siftDown(size_t pos) {
+        Node* node = heap[pos];
+        size_t n = heap.size();
+        while (true) {
+            size_t best = 2 * pos + 1;
+            if (best >= n) break;
+            if (best + 1 < n && heap[best + 1]->score > heap[best]->score) best++;
+            if (heap[best]->score <= node->score) break;
+            place(pos, heap[best]);
+            pos = best;
+        }
+        place(pos, node);
+    }
+
+public:
+    void push(Node* node) {
+        heap.push_back(node);
+        node->heapPos = heap.size() - 1;
+        siftUp(heap.size() - 1);
+    }
+
+    void remove(Node* node) {
+        size_t pos = node->heapPos;
+        Node* last = heap.back();
+        heap.pop_back();
+        if (last == node) return;
+
+        place(pos, last);
+        update(last);
+    }
+
+    // Restore heap order after node->score changed
+    void update(Node* node) {
+        size_t pos = node->heapPos;
+        if (pos > 0 && heap[(pos - 1) / 2]->score < node->score) {
+            siftUp(pos);
+        } else {
+            siftDown(pos);
+        }
+    }
+
+    Node* top() const {
+        return heap.empty() ? nullptr : heap.front();
+    }
+
+    void clear() {
+        heap.clear();
+    }
+
+    size_t size() const {
+        return heap.size();
+    }
+};
+
+#endif // SCORE_HEAP_H
@@ -14,288 +14,287 @@
 #include <iomanip>
 #include <chrono>
 #include <unistd.h>
-#include <zstd.h>
+#include <sys/resource.h>
+#include <random>
+#include <queue>
+#include <climits>
+#include <optional>
+
+#include "Post.h"
+#include "PostIndex.h"
+#include "ScoreHeap.h"
+#include "PostRange.h"
+#include "PostLoader.h"
+#include "FrozenSnapshot.h"
+#include "BasicTreap.h"
 
 using namespace std;
 
+// Heap priority used to balance the treap
+enum class PriorityMode {
+    Score,  // score is the heap priority - root is always the most popular post
+    Random  // independent random priority - O(log n) expected height regardless of scores
+};
+
+// BasicTreap priority policy chosen per treap at run time: the score
+// itself, or random priorities with a ScoreHeap on the side so that
+// getMostPopular stays O(1)
+struct PostPriority {
+    static constexpr bool heapOrdered = true;
+
+    template <typename Node>
+    struct Data {
+        unsigned int priority = 0; // Random heap priority (PriorityMode::Random)
+        size_t heapPos = 0;        // Slot in the popularity heap (PriorityMode::Random)
+    };
+
+    template <typename Node>
+    class Order {
+    private:
+        PriorityMode mode;
+        mt19937 rng;                // Priority source for PriorityMode::Random
+        ScoreHeap<Node> popularity; // Serves getMostPopular in PriorityMode::Random
+
+    public:
+        explicit Order(PriorityMode priorityMode = PriorityMode::Score) : mode(priorityMode), rng(time(0)) {}
+
+        PriorityMode getMode() const {
+            return mode;
+        }
+
+        void attach(Node* node) {
+            if (mode == PriorityMode::Random) {
+                node->priority = rng();
+                popularity.push(node);
+            }
+        }
+
+        void detach(Node* node) {
+            if (mode == PriorityMode::Random) popularity.remove(node);
+        }
+
+        // Score changed: Score mode re-sifts; in Random mode the shape does
+        // not depend on score - only the popularity heap moves
+        bool changed(Node* node) {
+            if (mode == PriorityMode::Score) return true;
+            popularity.update(node);
+            return false;
+        }
+
+        // Heap order between two nodes under the current priority mode
+        bool outranks(const Node* a, const Node* b) const {
+            if (mode == PriorityMode::Score) {
+                return a->score > b->score;
+            }
+            return a->priority > b->priority;
+        }
+
+        // Highest-score node: the root in Score mode, else the heap top
+        const Node* mostPopular(const Node* root) const {
+            return mode == PriorityMode::Score ? root : popularity.top();
+        }
+
+        void clear() {
+            popularity.clear();
+        }
+    };
+};
+
 class Treap {
 private:
-    struct TreapNode {
-        string postId;       // Unique identifier for the post
-        long long timestamp; // Key for BST ordering
-        int score;           // Priority for max-heap ordering
-        TreapNode* left;
-        TreapNode* right;
-        
-        TreapNode(string id, long long ts, int sc) 
-        : postId(id), timestamp(ts), score(sc), left(nullptr), right(nullptr) {}
-    };
+    // Keys never repeat (the index refuses a known postId), so DuplicateKeys
+    // only spares the descent its equality test
+    using Engine = BasicTreap<Post, PostPriority, less<PostKey>, DuplicateKeys, SubtreeSize, BackgroundReclaim>;
+    using TreapNode = Engine::Node;
+
+    Engine engine;              // Nodes, rotations, split/merge and the reclaimer thread
+    PostIndex<TreapNode> index; // postId -> node, O(1) expected lookup
 
-    TreapNode* root;
-    long long nodeCount;
-    long long rotationCount;
+    ///////////////////////////////////////////////////////
+    /////////////////////// Insert ////////////////////////
+    ///////////////////////////////////////////////////////
 
-    int calculateMinHeightHelper(TreapNode* node) {
-        if (!node) return 0;
-        return 1 + min(calculateMinHeightHelper(node->left), calculateMinHeightHelper(node->right));
+    // Insert a post while maintaining both BST and heap properties:
+    // attach as a leaf by (timestamp, postId), then sift up by priority
+    TreapNode* insert(const string& postId, long long timestamp, int score) {
+        TreapNode* created = engine.create(postId, timestamp, score);
+        index.insert(created);
+        engine.insert(created);
+        return created;
     }
 
     ///////////////////////////////////////////////////////
-    ///////////////////// Rotations ///////////////////////
+    /////////////////////// Search ////////////////////////
     ///////////////////////////////////////////////////////
 
-    // Left rotation to maintain heap property
-    TreapNode* leftRotate(TreapNode* node) {
-        if (!node || !node->right) return node;
-        
-        rotationCount++;
-        TreapNode* newRoot = node->right;
-        node->right = newRoot->left;
-        newRoot->left = node;
-        
-        return newRoot;
+    // Search for a post by ID through the postId index - O(1) expected
+    TreapNode* searchById(const string& postId) {
+        return index.find(postId);
     }
 
-    // Right rotation to maintain heap property
-    TreapNode* rightRotate(TreapNode* node) {
-        if (!node || !node->left) return node;
-        
-        rotationCount++;
-        TreapNode* newRoot = node->left;
-        node->left = newRoot->right;
-        newRoot->right = node;
-        
-        return newRoot;
+    // Search by composite key with one descent, no index needed - O(depth)
+    TreapNode* searchByKey(long long timestamp, const string& postId) {
+        return engine.find(PostKey(timestamp, postId));
     }
 
     ///////////////////////////////////////////////////////
-    /////////////////////// Insert ////////////////////////
+    ///////////////////// Deletion ////////////////////////
     ///////////////////////////////////////////////////////
 
-    // Helper function to insert a post while maintaining both BST and heap properties
-    TreapNode* insert(TreapNode* node, const string& postId, long long timestamp, int score) {
-        if (!node) {
-            return new TreapNode(postId, timestamp, score);
-        }
-        
-        // BST ordering by timestamp
-        if (timestamp < node->timestamp) {
-            node->left = insert(node->left, postId, timestamp, score);
-            
-            // Maintain max-heap property: rotate if child's score > parent's score
-            if (node->left && node->left->score > node->score) {
-                node = rightRotate(node);
-            }
-        } else if (timestamp > node->timestamp) {
-            node->right = insert(node->right, postId, timestamp, score);
-            
-            // Maintain max-heap property: rotate if child's score > parent's score
-            if (node->right && node->right->score > node->score) {
-                node = leftRotate(node);
-            }
-        } else {
-            // Handle duplicate timestamps - insert in right subtree
-            node->right = insert(node->right, postId, timestamp, score);
-            
-            // Maintain max-heap property
-            if (node->right && node->right->score > node->score) {
-                node = leftRotate(node);
-            }
-        }
-        
-        return node;
+    // Drop node from the index, then rotate it down and splice it out
+    void deleteNode(TreapNode* node) {
+        index.erase(node->postId);
+        engine.erase(node); // Slot goes on the free list for the next insert
     }
 
     ///////////////////////////////////////////////////////
-    /////////////////////// Search ////////////////////////
+    ///////////////// Order Statistics ////////////////////
     ///////////////////////////////////////////////////////
 
-    // Search for a post by ID
-    TreapNode* searchById(TreapNode* node, const string& postId) {
-        if (!node) return nullptr;
-        
-        if (node->postId == postId) {
-            return node;
-        }
-        
-        TreapNode* leftResult = searchById(node->left, postId);
-        if (leftResult) return leftResult;
-        
-        return searchById(node->right, postId);
+    // Number of posts with timestamp < ts (or <= ts when inclusive) - O(depth)
+    long long countBefore(long long ts, bool inclusive) {
+        return engine.countPrefix([ts, inclusive](const TreapNode* node) {
+            return node->timestamp < ts || (inclusive && node->timestamp == ts);
+        });
+    }
+
+    // k-th most recent node (1-based): the (n - k)-th in key order - O(depth)
+    TreapNode* selectNodeByRecency(long long k) {
+        if (k < 1 || k > (long long)engine.size()) return nullptr;
+        return engine.select(engine.size() - k);
+    }
+
+    // Recency rank of node (1 = most recent) - O(depth)
+    long long rankOfNode(const TreapNode* node) {
+        return engine.size() - engine.rankOf(node);
     }
 
     ///////////////////////////////////////////////////////
-    ///////////////////// Re-heapify //////////////////////
+    ////////////////// Top-k by Score /////////////////////
     ///////////////////////////////////////////////////////
 
-    // Find node by ID and perform rotations if needed after score update
-    TreapNode* updateAndReheapify(TreapNode* node, const string& postId) {
-        if (!node) return nullptr;
-        
-        if (node->postId == postId) {
-            // Found the node - now reheapify upward
-            return node;
-        }
-        
-        if (node->timestamp > 0) {
-            // Try left subtree
-            TreapNode* leftResult = updateAndReheapify(node->left, postId);
-            if (leftResult && leftResult->postId == postId) {
-                node->left = leftResult;
-                // Check if rotation needed
-                if (node->left && node->left->score > node->score) {
-                    node = rightRotate(node);
-                }
-                return leftResult;
+    // Score mode: the treap is a priority search tree (BST on timestamp,
+    // max-heap on score), so a best-first walk pops posts in descending
+    // score order. Each candidate carries the timestamp bounds of its
+    // subtree; subtrees entirely outside [from, to] are never pushed, which
+    // leaves only the two boundary paths as extra work - O((k + log n) log n).
+    size_t topKByHeapOrder(long long from, long long to, int k, PostView* out) {
+        struct Candidate {
+            const TreapNode* node;
+            long long lo, hi; // Timestamp bounds of the subtree
+            bool operator<(const Candidate& other) const {
+                return node->score < other.node->score;
             }
-        }
-        
-        // Try right subtree
-        TreapNode* rightResult = updateAndReheapify(node->right, postId);
-        if (rightResult && rightResult->postId == postId) {
-            node->right = rightResult;
-            // Check if rotation needed
-            if (node->right && node->right->score > node->score) {
-                node = leftRotate(node);
+        };
+
+        size_t count = 0;
+        priority_queue<Candidate> frontier;
+        if (engine.top()) frontier.push({engine.top(), LLONG_MIN, LLONG_MAX});
+
+        while (!frontier.empty() && count < (size_t)k) {
+            Candidate c = frontier.top();
+            frontier.pop();
+            const TreapNode* node = c.node;
+
+            if (node->timestamp >= from && node->timestamp <= to) {
+                out[count++] = viewOf(node);
             }
-            return rightResult;
-        }
-        
-        return nullptr;
-    }
-    
-    ///////////////////////////////////////////////////////
-    ///////////////////// Deletion ////////////////////////
-    ///////////////////////////////////////////////////////
-    
-    // Delete a post by ID
-    TreapNode* deleteById(TreapNode* node, const string& postId) {
-        if (!node) return nullptr;
-        
-        if (node->postId == postId) {
-            // Found the node to delete
-            if (!node->left) {
-                TreapNode* temp = node->right;
-                delete node;
-                return temp;
-            } else if (!node->right) {
-                TreapNode* temp = node->left;
-                delete node;
-                return temp;
+            if (node->left && c.lo <= to && node->timestamp >= from) {
+                frontier.push({node->left, c.lo, node->timestamp});
             }
-            
-            // Node with two children: rotate the child with lower score to leaf
-            // Then delete the leaf
-            if (node->left->score > node->right->score) {
-                node = rightRotate(node);
-                node->right = deleteById(node->right, postId);
-            } else {
-                node = leftRotate(node);
-                node->left = deleteById(node->left, postId);
+            if (node->right && node->timestamp <= to && c.hi >= from) {
+                frontier.push({node->right, node->timestamp, c.hi});
             }
-        } else {
-            // Search in both subtrees
-            node->left = deleteById(node->left, postId);
-            node->right = deleteById(node->right, postId);
         }
-        
-        return node;
+        return count;
     }
 
- 
     ///////////////////////////////////////////////////////
     ////////////////////// Utilities //////////////////////
     ///////////////////////////////////////////////////////
 
-    // Find minimum node (used in deletion)
-    TreapNode* findMin(TreapNode* node) {
-        while (node && node->left) {
-            node = node->left;
-        }
-        return node;
+    // Result view of a node for the typed queries
+    static PostView viewOf(const TreapNode* node) {
+        return PostView{node->postId, node->timestamp, node->score};
     }
 
-    // Reverse inorder traversal to get most recent posts
-    void reverseInorder(TreapNode* node, int k, vector<string>& result) {
-        if (!node || (int)result.size() >= k) return;
-        
-        // Right, Root, Left (for descending order of timestamps)
-        reverseInorder(node->right, k, result);
-        if ((int)result.size() < k) {
-            result.push_back(node->postId + " (TS: " + to_string(node->timestamp) + 
-                           ", Score: " + to_string(node->score) + ")");
+    // Most recent posts: start at the newest node and step to in-order
+    // predecessors through parent links - O(height + k), no stack
+    size_t reverseInorderIterative(int k, PostView* out) {
+        size_t count = 0;
+        const TreapNode* node = engine.last();
+        while (node && count < (size_t)max(k, 0)) {
+            out[count++] = viewOf(node);
+            node = PostRange<const TreapNode>::predecessor(node);
         }
-        reverseInorder(node->left, k, result);
-    }
-
-    // Calculate height of the tree
-    int getHeightHelper(TreapNode* node) {
-        if (!node) return 0;
-        return 1 + max(getHeightHelper(node->left), getHeightHelper(node->right));
+        return count;
     }
 
-    // Inorder traversal for debugging
-    void inorderHelper(TreapNode* node) {
-        if (node) {
-            inorderHelper(node->left);
-            cout << "[" << node->postId << ": T=" << node->timestamp 
-                 << ", S=" << node->score << "] ";
-            inorderHelper(node->right);
+    // Inorder traversal for debugging, via in-order successors
+    void inorderIterative() {
+        for (const TreapNode& node : engine) {
+            cout << "[" << node.postId << ": T=" << node.timestamp 
+                 << ", S=" << node.score << "] ";
         }
     }
 
-    // Clear the treap
-    void clear(TreapNode* node) {
-        if (node) {
-            clear(node->left);
-            clear(node->right);
-            delete node;
-        }
+    // Clear the treap: node destructors run and all slabs go back at once
+    void clear() {
+        engine.clear();
+        index.clear();
     }
 
     ////////////////////////////////////////////////
     /////////// Vertical Structure Print ////////////
     ///////////////////////////////////////////////
 
-    void printTreapStructure_helper(TreapNode* node, const string& prefix, bool isTail, const string& branchLabel) {
-        if (node == nullptr) {
-            return;
-        }
-
-        // Determine the connector string for the current node
-        cout << prefix;
-        if (isTail) {
-            // L-shaped corner: '└── '
-            cout << "\u2514\u2500\u2500 "; 
-        } else {
-            // T-shaped connector: '├── '
-            cout << "\u251C\u2500\u2500 "; 
-        }
+    // Pre-order print of the subtree under node; an explicit stack of
+    // pending frames replaces recursion so deep treaps cannot overflow
+    void printTreapStructure_helper(const TreapNode* node, const string& prefix, bool isTail, const string& branchLabel) {
+        struct Frame {
+            const TreapNode* node;
+            string prefix;
+            bool isTail;
+            const char* branchLabel;
+        };
+
+        vector<Frame> pending;
+        if (node != nullptr) pending.push_back({node, prefix, isTail, branchLabel.c_str()});
+
+        while (!pending.empty()) {
+            Frame frame = std::move(pending.back());
+            pending.pop_back();
+
+            // Determine the connector string for the current node
+            cout << frame.prefix;
+            if (frame.isTail) {
+                // L-shaped corner: '└── '
+                cout << "\u2514\u2500\u2500 "; 
+            } else {
+                // T-shaped connector: '├── '
+                cout << "\u251C\u2500\u2500 "; 
+            }
 
-        // Print the node's data: Timestamp (BST Key), Priority (Heap Key), and Branch Label
-        cout << "TS: " << node->timestamp << branchLabel 
-            << " | ID: " << node->postId 
-            << " | Score: " << node->score << endl;
+            // Print the node's data: Timestamp (BST Key), Priority (Heap Key), and Branch Label
+            cout << "TS: " << frame.node->timestamp << frame.branchLabel 
+                << " | ID: " << frame.node->postId 
+                << " | Score: " << frame.node->score << endl;
 
-        // The new prefix for the children
-        string newPrefix = prefix + (isTail ? "    " : "\u2502   "); // '|   ' or '    '
+            // The new prefix for the children
+            string newPrefix = frame.prefix + (frame.isTail ? "    " : "\u2502   "); // '|   ' or '    '
 
-        // Recursive calls for children
-        
-        // 1. Process the Left child
-        // Left child is the 'tail' only if the right child is null.
-        if (node->left != nullptr) {
-            printTreapStructure_helper(node->left, newPrefix, node->right == nullptr, " (L)");
-        }
-        
-        // 2. Process the Right child
-        // Right child is ALWAYS the tail.
-        if (node->right != nullptr) {
-            printTreapStructure_helper(node->right, newPrefix, true, " (R)");
+            // Push right first so the left child is printed first.
+            // Right child is ALWAYS the tail; left is the tail only if there is no right child.
+            if (frame.node->right != nullptr) {
+                pending.push_back({frame.node->right, newPrefix, true, " (R)"});
+            }
+            if (frame.node->left != nullptr) {
+                pending.push_back({frame.node->left, newPrefix, frame.node->right == nullptr, " (L)"});
+            }
         }
     }
 
-    void printTreapStructure(TreapNode* root) {
+    void printTreapStructure(const TreapNode* root) {
         if (root == nullptr) {
             cout << "The treap is empty." << endl;
             return;
@@ -322,14 +321,19 @@ private:
 
 
 public:
-    Treap() : root(nullptr), nodeCount(0), rotationCount(0) {
+    explicit Treap(PriorityMode priorityMode = PriorityMode::Score)
+    : engine(Engine::PriorityOrder(priorityMode)) {
         srand(time(0));
     }
+
+    PriorityMode getPriorityMode() const {
+        return engine.priorityOrder().getMode();
+    }
     
     void printPostById(const string& postId)
     {
         cout << "[TREAP] ";
-        TreapNode* node = searchById(root, postId);
+        TreapNode* node = searchById(postId);
         if (node) {
             cout << "Post Found: [" << node->postId << ": T=" << node->timestamp 
                  << ", S=" << node->score << "]" << endl;
@@ -340,97 +344,217 @@ public:
 
 
     int calculateMinHeight() {
-        return calculateMinHeightHelper(root);
+        return engine.getMinHeight();
     }
 
-    // Add a post to the treap
+    // Add a post to the treap (post IDs are unique - re-adding an existing ID is ignored)
     void addPost(const string& postId, long long timestamp, int score) {
-        root = insert(root, postId, timestamp, score);
-        nodeCount++;
+        if (index.find(postId)) return;
+        insert(postId, timestamp, score);
     }
     
     // Delete a post from the treap
     void deletePost(const string& postId) {
-        root = deleteById(root, postId);
+        TreapNode* node = searchById(postId);
+        if (!node) return;
+
+        deleteNode(node);
+    }
+
+    // Post with exactly this (timestamp, postId), or nullptr - O(log n),
+    // a fast path for callers that know the creation time
+    const TreapNode* find(long long timestamp, const string& postId) {
+        return searchByKey(timestamp, postId);
+    }
+
+    // Delete the post with this (timestamp, postId) - O(log n).
+    // Returns false if there is no such post.
+    bool erase(long long timestamp, const string& postId) {
+        TreapNode* node = searchByKey(timestamp, postId);
+        if (!node) return false;
+
+        deleteNode(node);
+        return true;
     }
     
+    // Adjust a post's score by delta (likes, unlikes, corrections) and
+    // restore heap order in place - O(depth). Returns false if not found.
+    bool updateScore(const string& postId, int delta) {
+        TreapNode* node = searchById(postId);
+        if (!node) return false;
+
+        node->score += delta;
+        engine.changed(node);
+        return true;
+    }
+
     // Increment score and reheapify
     void likePost(const string& postId) {
-        TreapNode* node = searchById(root, postId);
-        if (node) {
-            node->score++;
-            // Reheapify: bubble up if needed
-            root = reheapifyUp(root, postId);
-        }
+        updateScore(postId, 1);
     }
 
     // Get number of rotations performed
     long long getRotationCount() const {
-        return rotationCount;
+        return engine.getRotationCount();
     }
 
     // reset rotation count
     void resetRotationCount() {
-        rotationCount = 0;
+        engine.resetRotationCount();
     }
 
-    // Reheapify after score update - bubble up the node
-    TreapNode* reheapifyUp(TreapNode* node, const string& postId) {
-        if (!node) return nullptr;
-        
-        if (node->postId == postId) {
-            return node;
+    // Get the most popular post (highest score) - O(1)
+    // Score mode: the heap root. Random mode: top of the popularity heap.
+    optional<PostView> getMostPopular() {
+        const TreapNode* top = engine.priorityOrder().mostPopular(engine.top());
+        if (top) {
+            return viewOf(top);
         }
-        
-        // Recursively fix left subtree
-        if (node->left) {
-            node->left = reheapifyUp(node->left, postId);
-            if (node->left->score > node->score) {
-                node = rightRotate(node);
-            }
+        return nullopt;
+    }
+    
+    // k most recent posts, newest first, written to out (room for k) -
+    // returns how many were written
+    size_t getMostRecent(int k, PostView* out) {
+        return reverseInorderIterative(k, out);
+    }
+    
+    // Number of posts with t1 <= timestamp <= t2 - O(log n)
+    long long countInRange(long long t1, long long t2) {
+        if (t1 > t2) return 0;
+        return countBefore(t2, true) - countBefore(t1, false);
+    }
+
+    // k-th most recent post (k = 1 is the newest) - O(log n)
+    optional<PostView> selectByRecency(long long k) {
+        TreapNode* node = selectNodeByRecency(k);
+        if (node) {
+            return viewOf(node);
         }
-        
-        // Recursively fix right subtree
-        if (node->right) {
-            node->right = reheapifyUp(node->right, postId);
-            if (node->right->score > node->score) {
-                node = leftRotate(node);
-            }
+        return nullopt;
+    }
+
+    // Recency rank of a post (1 = most recent), 0 if not found - O(log n)
+    long long rankOf(const string& postId) {
+        TreapNode* node = searchById(postId);
+        return node ? rankOfNode(node) : 0;
+    }
+
+    // Posts with from <= timestamp <= to, iterable oldest-first (begin/end)
+    // or newest-first (reversed()) without copying - O(log n + k)
+    PostRange<const TreapNode> rangeQuery(long long from, long long to) {
+        return PostRange<const TreapNode>(engine.top(), from, to);
+    }
+
+    // Pointer-free, read-only copy of the current posts for search-heavy
+    // phases - O(n). Later inserts/deletes are not reflected in it
+    FrozenSnapshot freeze() {
+        return FrozenSnapshot(PostRange<const TreapNode>(engine.top(), LLONG_MIN, LLONG_MAX), engine.size());
+    }
+
+    // Top k posts by score with from <= timestamp <= to, highest first,
+    // written to out (room for k) - returns how many were written.
+    // Random mode has no heap order on score, so the window is scanned
+    // keeping the k best - O(log n + m log k) for m posts in the window
+    size_t topKByScore(long long from, long long to, int k, PostView* out) {
+        if (k <= 0 || from > to) return 0;
+        if (getPriorityMode() == PriorityMode::Score) {
+            return topKByHeapOrder(from, to, k, out);
         }
-        
-        return node;
+        return keepTopKByScore(rangeQuery(from, to), k, out);
     }
-    
-    // Get the most popular post (highest score) - O(1)
-    string getMostPopular() {
-        if (root) {
-            return root->postId + " (Score: " + to_string(root->score) + 
-                   ", Timestamp: " + to_string(root->timestamp) + ")";
+
+    // Replace the treap contents with posts in O(n) via Cartesian-tree
+    // construction (plus an O(n log n) sort if they are not already in
+    // timestamp order)
+    void buildFromSorted(vector<Post>&& posts) {
+        clear();
+
+        auto byKey = [](const Post& a, const Post& b) { return postKeyLess(a, b); };
+        if (!is_sorted(posts.begin(), posts.end(), byKey)) {
+            stable_sort(posts.begin(), posts.end(), byKey);
         }
-        return "No posts found";
+
+        vector<TreapNode*> nodes;
+        nodes.reserve(posts.size());
+        index.reserve(posts.size());
+        for (Post& post : posts) {
+            TreapNode* node = engine.create(std::move(post));
+            if (!index.insert(node)) {
+                engine.discard(node); // Post IDs are unique - duplicates are ignored
+                continue;
+            }
+            nodes.push_back(node);
+        }
+        posts.clear();
+
+        engine.append(nodes); // Cartesian-tree construction
     }
-    
-    // Get k most recent posts
-    vector<string> getMostRecent(int k) {
-        vector<string> result;
-        reverseInorder(root, k, result);
-        return result;
+
+    // Drop every post with timestamp < ts (retention policy). The old part is
+    // split off in O(log n); its IDs still have to leave the index, then the
+    // nodes are destroyed in bulk - on a background thread if requested, in
+    // which case their slots become reusable at the next eviction or clear().
+    // Returns the number of evicted posts.
+    long long evictOlderThan(long long ts, bool freeInBackground = false) {
+        return engine.evictPrefix([ts](const TreapNode* node) { return node->timestamp < ts; },
+                                  [this](const TreapNode* node) { index.erase(node->postId); },
+                                  freeInBackground);
     }
-    
+
+    // Insert many posts at once via split-insert-merge. A batch that is
+    // entirely newer than the tree (the usual case for fresh posts) is built
+    // on its own and attached with a single merge. Returns posts inserted.
+    long long insertBatch(vector<Post> posts) {
+        stable_sort(posts.begin(), posts.end(), [](const Post& a, const Post& b) {
+            return postKeyLess(a, b);
+        });
+
+        const TreapNode* newest = engine.last();
+        bool appendOnly = !newest || posts.empty() || postKeyLess(*newest, posts.front());
+
+        vector<TreapNode*> batch;
+        long long inserted = 0;
+        for (Post& post : posts) {
+            TreapNode* node = engine.create(std::move(post));
+            if (!index.insert(node)) {
+                engine.discard(node); // Post IDs are unique - duplicates are ignored
+                continue;
+            }
+            inserted++;
+
+            if (appendOnly) {
+                batch.push_back(node);
+            } else {
+                engine.insertBySplit(node);
+            }
+        }
+
+        if (appendOnly) engine.append(batch);
+        return inserted;
+    }
+
     // Get tree height
     int getHeight() {
-        return getHeightHelper(root);
+        return engine.getHeight();
     }
     
     // get number of nodes
     long long getNodeCount() const {
-        return nodeCount;
+        return engine.size();
+    }
+
+    // Process RSS plus the bytes held by this treap's node arena and index
+    MemoryUsage getMemoryUsage() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return MemoryUsage{usage.ru_maxrss / 1024, engine.memoryBytes(), engine.liveBytes(), index.memoryBytes()};
     }
     
 
     // Destructor
     ~Treap() {
-        clear(root);
+        clear();
     }
     
     ///////////////////////////////////////////////////////
@@ -477,326 +601,121 @@ public:
     // Does NOT create temporary decompressed file on disk
     
 
-    double loadFromCSV(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "[Treap] Unable to open CSV file: " << filename << std::endl;
-            return 0.0;
-        }
-        
-        std::string line;
-        long long lineCount = 0;
-        
+    // 30-second sample; returns the projected time for the full dataset, or
+    // the load time if the whole file fit in the sample.
+    // bulkBuild: parse every row first, then buildFromSorted() once at the end
+    double loadFromCSV(const std::string& filename, bool bulkBuild = false) {
         std::cout << "[Treap] Starting CSV load from: " << filename << std::endl;
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
-        // Skip header line if exists
-        std::getline(file, line);
-        
-        while (std::getline(file, line)) {
-            size_t pos1 = line.find(',');
-            size_t pos2 = line.find(',', pos1 + 1);
-            
-            if (pos1 == std::string::npos || pos2 == std::string::npos) {
-                continue; // Skip invalid lines
-            }
-            
-            std::string id = line.substr(0, pos1);
-            long long timestamp = std::stoll(line.substr(pos1 + 1, pos2 - pos1 - 1));
-            int score = std::stoi(line.substr(pos2 + 1));
-            
-            addPost(id, timestamp, score);
-            lineCount++;
-            
-            // Progress update every 100,000 posts
-            if (lineCount % 100 == 0) {
-                break;
-                auto currentTime = std::chrono::high_resolution_clock::now();
-                double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-                double rate = lineCount / elapsedSec;
-                std::cout << "\r[Treap] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                        << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s" 
-                        << std::string(20, ' ') << std::flush;
-            }
-        }
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
-        
+
+        std::vector<Post> parsed;
+        LoadStats stats = PostLoader::readCSV(filename, "[Treap]", 30.0,
+            [&](string_view id, long long timestamp, int score) {
+                if (bulkBuild) {
+                    parsed.push_back({string(id), timestamp, score});
+                } else {
+                    addPost(string(id), timestamp, score);
+                }
+            });
+        if (!stats.opened) return 0.0;
+        if (bulkBuild) buildFromSorted(std::move(parsed));
+
         std::cout << "\n[Treap] CSV LOAD COMPLETE" << std::endl;
-        std::cout << "[Treap] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(3) << totalTime 
+        std::cout << "[Treap] Posts: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3) << stats.seconds
                   << "s | Height: " << getHeight() << std::endl;
-        
-        file.close();
-        return totalTime;
+
+        return stats.timedOut ? PostLoader::estimateFullLoad(stats) : stats.seconds;
     }
 
 
-    double loadFromTGZ(const std::string& tgzFilename) {
+    // 30-second sample of the zstd JSON dump; returns the projected time for
+    // the full dataset, or the load time if the whole dump fit in the sample.
+    // bulkBuild: parse every record first, then buildFromSorted() once at the end
+    double loadFromTGZ(const std::string& tgzFilename, bool bulkBuild = false) {
         std::cout << "[Treap] Loading from compressed dataset: " << tgzFilename << std::endl;
-        
-        // Use streaming approach - create a pipe that decompresses on demand
-        std::string cmd = "zstd -dc '" + tgzFilename + "' 2>/dev/null";
-        FILE* f = popen(cmd.c_str(), "r");
-        if (!f) {
-            std::cerr << "[Treap] Failed to open pipe" << std::endl;
-            return 0.0;
-        }
-        
-        char buffer[65536];
-        long long lineCount = 0;
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
         std::cout << "[Treap] Starting streaming load..." << std::endl;
-        
-        std::string fullLine;
-        while (fgets(buffer, sizeof(buffer), f) != nullptr) {
-            fullLine += buffer;
-            
-            // Check if we have a complete JSON object (ends with })
-            size_t pos = fullLine.rfind("}");
-            if (pos != std::string::npos && (pos + 1 >= fullLine.length() || fullLine[pos + 1] == '\n')) {
-                std::string line = fullLine.substr(0, pos + 1);
-                fullLine = (pos + 1 < fullLine.length()) ? fullLine.substr(pos + 1) : "";
-                
-                if (line.empty()) continue;
-                
-                // Parse JSON
-                std::string id, timestamp_str, score_str;
-                
-                size_t id_pos = line.find("\"id\":\"");
-                if (id_pos != std::string::npos) {
-                    size_t id_start = id_pos + 6;
-                    size_t id_end = line.find("\"", id_start);
-                    if (id_end != std::string::npos) {
-                        id = line.substr(id_start, id_end - id_start);
-                    }
-                }
-                
-                size_t ts_pos = line.find("\"created_utc\":");
-                if (ts_pos != std::string::npos) {
-                    size_t ts_start = ts_pos + 14;
-                    size_t ts_end = line.find(",", ts_start);
-                    if (ts_end != std::string::npos) {
-                        timestamp_str = line.substr(ts_start, ts_end - ts_start);
-                    }
-                }
-                
-                size_t score_pos = line.find("\"score\":");
-                if (score_pos != std::string::npos) {
-                    size_t score_start = score_pos + 8;
-                    size_t score_end = line.find(",", score_start);
-                    if (score_end == std::string::npos) {
-                        score_end = line.find("}", score_start);
-                    }
-                    if (score_end != std::string::npos) {
-                        score_str = line.substr(score_start, score_end - score_start);
-                    }
-                }
-                
-                if (!id.empty() && !timestamp_str.empty() && !score_str.empty()) {
-                    try {
-                        long long timestamp = std::stoll(timestamp_str);
-                        int score = std::stoi(score_str);
-                        
-                        addPost(id, timestamp, score);
-                        lineCount++;
-                        
-                        if (lineCount % 10000 == 0) {
-                            auto currentTime = std::chrono::high_resolution_clock::now();
-                            double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-                            double rate = lineCount / elapsedSec;
-                            std::cout << "\r[Treap] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                                      << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s" 
-                                      << std::flush;
-                        }
-                    } catch (...) {
-                        continue;
-                    }
+
+        std::vector<Post> parsed;
+        LoadStats stats = PostLoader::readZST(tgzFilename, "[Treap]", 30.0, !bulkBuild,
+            [&](string_view id, long long timestamp, int score) {
+                if (bulkBuild) {
+                    parsed.push_back({string(id), timestamp, score});
+                } else {
+                    addPost(string(id), timestamp, score);
                 }
-            }
-        }
-        
-        pclose(f);
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
-        
+            });
+        if (!stats.opened) return 0.0;
+        if (bulkBuild) buildFromSorted(std::move(parsed));
+
         std::cout << "\n[Treap] LOAD COMPLETE" << std::endl;
-        std::cout << "[Treap] Posts Loaded: " << lineCount << " | Time: " << std::fixed << std::setprecision(3) 
-                  << totalTime << "s | Tree Height: " << getHeight() << std::endl;
-        return totalTime;
+        std::cout << "[Treap] Posts Loaded: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3)
+                  << stats.seconds << "s | Tree Height: " << getHeight() << std::endl;
+
+        return stats.timedOut ? PostLoader::estimateFullLoad(stats) : stats.seconds;
     }
 
 
     void loadFromCSVWithTimeout(const std::string& filename, int timeoutSeconds = 30) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "[Treap] Unable to open CSV file: " << filename << std::endl;
-            return;
-        }
-
-        std::string line;
-        long long lineCount = 0;
-
         std::cout << "[Treap] Starting CSV load from: " << filename << std::endl;
         std::cout << "[Treap] Timeout: " << timeoutSeconds << " seconds" << std::endl;
 
-        auto startTime = std::chrono::high_resolution_clock::now();
+        LoadStats stats = PostLoader::readCSV(filename, "[Treap]", timeoutSeconds,
+            [this](string_view id, long long timestamp, int score) {
+                addPost(string(id), timestamp, score);
+            });
+        if (!stats.opened) return;
+        if (stats.timedOut) std::cout << "\n[Treap] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
 
-        // Skip header line if exists
-        std::getline(file, line);
+        std::cout << "\n --------- [Treap] CSV LOAD COMPLETE ----------- " << std::endl;
+        std::cout << "[Treap] Posts: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3) << stats.seconds
+                    << "s | Height: " << getHeight() << std::endl << std::endl;
+    }
 
-        while (std::getline(file, line)) {
-            // Check timeout
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-            if (elapsedSec >= timeoutSeconds) {
-                std::cout << "\n[Treap] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
-                break;
-            }
-            
-            size_t pos1 = line.find(',');
-            size_t pos2 = line.find(',', pos1 + 1);
-            
-            if (pos1 == std::string::npos || pos2 == std::string::npos) {
-                continue;
-            }
-            
-            std::string id = line.substr(0, pos1);
-            long long timestamp = std::stoll(line.substr(pos1 + 1, pos2 - pos1 - 1));
-            int score = std::stoi(line.substr(pos2 + 1));
-            
-            addPost(id, timestamp, score);
-            lineCount++;
-            
-            if (lineCount % 100 == 0) {
-                double rate = lineCount / elapsedSec;
-                std::cout << "\r[Treap] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                        << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s" 
-                        << std::string(20, ' ') << std::flush;
-            }
-        }
+    // Whole CSV parsed on threads cores (0 = all of them) and bulk built, or
+    // as much of it as is parsed within timeLimit seconds
+    ParallelLoadStats loadFromCSVParallel(const std::string& filename, int threads = 0, double timeLimit = 30.0) {
+        std::cout << "[Treap] Starting parallel CSV load from: " << filename << std::endl;
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
+        std::vector<Post> parsed;
+        ParallelLoadStats stats = PostLoader::readCSVParallel(filename, "[Treap]", timeLimit, threads, parsed);
+        if (!stats.opened) return stats;
 
-        std::cout << "\n --------- [Treap] CSV LOAD COMPLETE ----------- " << std::endl;
-        std::cout << "[Treap] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(3) << totalTime 
-                    << "s | Height: " << getHeight() << std::endl << std::endl;
+        auto buildStart = std::chrono::high_resolution_clock::now();
+        buildFromSorted(std::move(parsed));
+        stats.buildSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - buildStart).count();
+        stats.seconds += stats.buildSeconds;
 
-        file.close();
-        }
+        if (stats.timedOut) std::cout << "\n[Treap] TIMEOUT after " << timeLimit << " seconds" << std::endl;
+        std::cout << "\n --------- [Treap] PARALLEL CSV LOAD COMPLETE ----------- " << std::endl;
+        std::cout << "[Treap] Posts: " << stats.posts << " | Threads: " << stats.threads << " | Time: " << std::fixed
+                  << std::setprecision(3) << stats.seconds << "s | Height: " << getHeight() << std::endl << std::endl;
+        return stats;
+    }
 
 
     void loadFromTGZWithTimeout(const std::string& tgzFilename, int timeoutSeconds = 30) {
-        // std::cout << "[Treap] Loading from compressed dataset: " << tgzFilename << std::endl;
-        // std::cout << "[Treap] Timeout: " << timeoutSeconds << " seconds" << std::endl;
-        
-        std::string cmd = "zstd -dc '" + tgzFilename + "' 2>/dev/null";
-        FILE* f = popen(cmd.c_str(), "r");
-        if (!f) {
-            std::cerr << "[Treap] Failed to open pipe" << std::endl;
-            return;
-        }
-        
-        char buffer[65536];
-        long long lineCount = 0;
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
         std::cout << "[Treap] Starting streaming load..." << std::endl;
-        
-        std::string fullLine;
-        while (fgets(buffer, sizeof(buffer), f) != nullptr) {
-            // Check timeout
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            double elapsedSec = std::chrono::duration<double>(currentTime - startTime).count();
-            if (elapsedSec >= timeoutSeconds) {
-                std::cout << "\n[Treap] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
-                break;
-            }
-            
-            fullLine += buffer;
-            
-            size_t pos = fullLine.rfind("}");
-            if (pos != std::string::npos && (pos + 1 >= fullLine.length() || fullLine[pos + 1] == '\n')) {
-                std::string line = fullLine.substr(0, pos + 1);
-                fullLine = (pos + 1 < fullLine.length()) ? fullLine.substr(pos + 1) : "";
-                
-                if (line.empty()) continue;
-                
-                std::string id, timestamp_str, score_str;
-                
-                size_t id_pos = line.find("\"id\":\"");
-                if (id_pos != std::string::npos) {
-                    size_t id_start = id_pos + 6;
-                    size_t id_end = line.find("\"", id_start);
-                    if (id_end != std::string::npos) {
-                        id = line.substr(id_start, id_end - id_start);
-                    }
-                }
-                
-                size_t ts_pos = line.find("\"created_utc\":");
-                if (ts_pos != std::string::npos) {
-                    size_t ts_start = ts_pos + 14;
-                    size_t ts_end = line.find(",", ts_start);
-                    if (ts_end != std::string::npos) {
-                        timestamp_str = line.substr(ts_start, ts_end - ts_start);
-                    }
-                }
-                
-                size_t score_pos = line.find("\"score\":");
-                if (score_pos != std::string::npos) {
-                    size_t score_start = score_pos + 8;
-                    size_t score_end = line.find(",", score_start);
-                    if (score_end == std::string::npos) {
-                        score_end = line.find("}", score_start);
-                    }
-                    if (score_end != std::string::npos) {
-                        score_str = line.substr(score_start, score_end - score_start);
-                    }
-                }
-                
-                if (!id.empty() && !timestamp_str.empty() && !score_str.empty()) {
-                    try {
-                        long long timestamp = std::stoll(timestamp_str);
-                        int score = std::stoi(score_str);
-                        
-                        addPost(id, timestamp, score);
-                        lineCount++;
-                        
-                        if (lineCount % 100 == 0) {
-                            double rate = lineCount / elapsedSec;
-                            std::cout << "\r[Treap] Posts: " << lineCount << " | Time: " << std::fixed << std::setprecision(2) 
-                                    << elapsedSec << "s | Rate: " << std::fixed << std::setprecision(0) << rate << " posts/s | "
-                                    << "Remaining: " << (timeoutSeconds - (int)elapsedSec) << "s" << std::flush;
-                        }
-                    } catch (...) {
-                        continue;
-                    }
-                }
-            }
-        }
-        
-        pclose(f);
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double totalTime = std::chrono::duration<double>(endTime - startTime).count();
-        
+
+        LoadStats stats = PostLoader::readZST(tgzFilename, "[Treap]", timeoutSeconds,
+            [this](string_view id, long long timestamp, int score) {
+                addPost(string(id), timestamp, score);
+            });
+        if (!stats.opened) return;
+        if (stats.timedOut) std::cout << "\n[Treap] TIMEOUT after " << timeoutSeconds << " seconds" << std::endl;
+
         std::cout << "\n --------- [Treap] LOAD COMPLETE ---------- " << std::endl;
-        std::cout << "[Treap] Posts Loaded: " << lineCount << " | Time: " << std::fixed << std::setprecision(3) 
-                << totalTime << "s | Tree Height: " << getHeight() << std::endl << std::endl;
+        std::cout << "[Treap] Posts Loaded: " << stats.posts << " | Time: " << std::fixed << std::setprecision(3)
+                << stats.seconds << "s | Tree Height: " << getHeight() << std::endl << std::endl;
     }
 
 
     void printTreapStructure() {
-        printTreapStructure(root);
+        printTreapStructure(engine.top());
     }
 
     // Print tree inorder for debugging
     void printTreeInorder() {
         cout << "Treap Inorder: ";
-        inorderHelper(root);
+        inorderIterative();
         cout << endl;
     }
 
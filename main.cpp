@@ -10,19 +10,19 @@ void test_tescases_bst()
     bst.addPost("ejualne", 1554076800, 14);
     bst.addPost("ejualnl", 1554076809, 13);
 
-    cout << "BST Most Popular: " << bst.getMostPopular() << endl;
+    cout << "BST Most Popular: " << MenuSystem::formatPopular(bst.getMostPopular()) << endl;
  
     bst.printVerticalStructure();    cout << endl;
     bst.likePost("ejualnl");
     bst.likePost("ejualnl");
 
-    cout << "BST Most Popular: " << bst.getMostPopular() << endl;
+    cout << "BST Most Popular: " << MenuSystem::formatPopular(bst.getMostPopular()) << endl;
 
     bst.printVerticalStructure();  cout << endl;
     
     bst.deletePost("ejualnc");
     
-    cout << "BST Most Popular: " << bst.getMostPopular() << endl;
+    cout << "BST Most Popular: " << MenuSystem::formatPopular(bst.getMostPopular()) << endl;
     
     bst.printVerticalStructure();  cout << endl;
 
@@ -38,20 +38,20 @@ void test_tescases_treap()
     treap.addPost("ejualne", 1554076800, 14);
     treap.addPost("ejualnl", 1554076809, 13);
 
-    cout << "Treap Most Popular: " << treap.getMostPopular() << endl;
+    cout << "Treap Most Popular: " << MenuSystem::formatPopular(treap.getMostPopular()) << endl;
  
     treap.printTreapStructure();    cout << endl;
 
     treap.likePost("ejualnl");
     treap.likePost("ejualnl");
 
-    cout << "Treap Most Popular: " << treap.getMostPopular() << endl;
+    cout << "Treap Most Popular: " << MenuSystem::formatPopular(treap.getMostPopular()) << endl;
 
     treap.printTreapStructure();  cout << endl;
     
     treap.deletePost("ejualnc");
     
-    cout << "Treap Most Popular: " << treap.getMostPopular() << endl;
+    cout << "Treap Most Popular: " << MenuSystem::formatPopular(treap.getMostPopular()) << endl;
     
     treap.printTreapStructure();  cout << endl;
 }
@@ -68,9 +68,9 @@ int main() {
     // treap.loadFromCSV("/media/daniyal/New Volume/DataSet/reddit_data.csv");
 
     // treap.getMostRecent()
-    // cout << treap.getMostPopular() << endl;
+    // cout << MenuSystem::formatPopular(treap.getMostPopular()) << endl;
     // treap.deletePost("ejualo4");
-    // cout << treap.getMostPopular() << endl;
+    // cout << MenuSystem::formatPopular(treap.getMostPopular()) << endl;
     // treap.addPost("Daniyal", 10000, 200);
 
 
@@ -0,0 +1,56 @@
+import matplotlib.pyplot as plt
+import sys
+import os
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+
+    # Parse arguments: one group of five per run
+    # threads, posts, parse seconds, merge seconds, build seconds
+    threads, posts, parse_times, merge_times, build_times = [], [], [], [], []
+    for i in range(0, len(args) - 4, 5):
+        threads.append(int(args[i]))
+        posts.append(int(args[i + 1]))
+        parse_times.append(float(args[i + 2]))
+        merge_times.append(float(args[i + 3]))
+        build_times.append(float(args[i + 4]))
+
+    # Throughput of the parallel part (parse + merge)
+    rates = [p / (t1 + t2) if t1 + t2 > 0 else 0.0 for p, t1, t2 in zip(posts, parse_times, merge_times)]
+    speedups = [r / rates[0] if rates[0] > 0 else 0.0 for r in rates]
+
+    # Create subplots
+    fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(12, 5))
+
+    # Left: Speedup against ideal scaling
+    ax1.plot(threads, speedups, 'o-', color='blue', label='Measured')
+    ax1.plot(threads, [t / threads[0] for t in threads], '--', color='gray', label='Ideal')
+    ax1.set_xlabel('Threads')
+    ax1.set_ylabel('Speedup (posts/s vs 1 thread)')
+    ax1.set_title('Parallel CSV Parsing Scaling')
+    ax1.legend()
+    ax1.grid(True, alpha=0.3)
+
+    # Add value labels on points
+    for t, s in zip(threads, speedups):
+        ax1.text(t, s, f'{s:.2f}x', ha='center', va='bottom')
+
+    # Right: Time per phase
+    labels = [str(t) for t in threads]
+    ax2.bar(labels, parse_times, color='blue', alpha=0.7, label='Parse + sort')
+    ax2.bar(labels, merge_times, bottom=parse_times, color='purple', alpha=0.7, label='Merge')
+    ax2.bar(labels, build_times, bottom=[p + m for p, m in zip(parse_times, merge_times)],
+            color='teal', alpha=0.7, label='Bulk build')
+    ax2.set_xlabel('Threads')
+    ax2.set_ylabel('Time (seconds)')
+    ax2.set_title('Loading Time by Phase')
+    ax2.legend()
+    ax2.grid(True, alpha=0.3)
+
+    plt.tight_layout()
+
+    os.makedirs('graphs', exist_ok=True)
+    plt.savefig('graphs/csv_loading_scaling.png', dpi=300, bbox_inches='tight')
+    print("✅ Scaling graph saved as: ../graphs/csv_loading_scaling.png")
+
+    plt.show()
@@ -16,7 +16,11 @@ if __name__ == "__main__":
         treap_times = [float(x) for x in args[4:6]]  # Next 2 are Treap times
         bst_heights = [int(x) for x in args[6:8]]  # Next 2 are BST heights
         treap_heights = [int(x) for x in args[8:10]]  # Next 2 are Treap heights
-        rotations = [int(x) for x in args[10:]]  # Last 2 are rotations
+        rotations = [int(x) for x in args[10:12]]  # Next 2 are Treap rotations
+        avl_times = [float(x) for x in args[12:14]]  # Optional: AVL times
+        avl_heights = [int(x) for x in args[14:16]]  # Optional: AVL heights
+        bplus_times = [float(x) for x in args[16:18]]  # Optional: B+ tree times
+        bplus_heights = [int(x) for x in args[18:20]]  # Optional: B+ tree heights
         
         print(f"Sizes: {sizes}")
         print(f"BST Times: {bst_times}")
@@ -31,6 +35,10 @@ if __name__ == "__main__":
         # Left: Deletion time comparison
         ax1.plot(sizes, bst_times, 'ro-', label='BST', linewidth=2, markersize=8)
         ax1.plot(sizes, treap_times, 'bo-', label='Treap', linewidth=2, markersize=8)
+        if avl_times:
+            ax1.plot(sizes, avl_times, 'mo-', label='AVL', linewidth=2, markersize=8)
+        if bplus_times:
+            ax1.plot(sizes, bplus_times, 'co-', label='B+ Tree', linewidth=2, markersize=8)
         ax1.set_xlabel('Dataset Size (posts)')
         ax1.set_ylabel('Deletion Time (ms)')
         ax1.set_title('Deletion Time vs Dataset Size')
@@ -40,6 +48,10 @@ if __name__ == "__main__":
         # Middle: Tree height comparison
         ax2.plot(sizes, bst_heights, 'ro-', label='BST Height', linewidth=2, markersize=8)
         ax2.plot(sizes, treap_heights, 'bo-', label='Treap Height', linewidth=2, markersize=8)
+        if avl_heights:
+            ax2.plot(sizes, avl_heights, 'mo-', label='AVL Height', linewidth=2, markersize=8)
+        if bplus_heights:
+            ax2.plot(sizes, bplus_heights, 'co-', label='B+ Tree Height', linewidth=2, markersize=8)
         ax2.set_xlabel('Dataset Size (posts)')
         ax2.set_ylabel('Tree Height')
         ax2.set_title('Tree Height vs Dataset Size')
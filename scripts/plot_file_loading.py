@@ -14,6 +14,8 @@ if __name__ == "__main__":
     treap_csv_height = int(args[5])
     bst_tgz_height = int(args[6])
     treap_tgz_height = int(args[7])
+    avl_values = [int(x) for x in args[8:12]]  # Optional: AVL CSV/TGZ posts, then CSV/TGZ heights
+    bplus_values = [int(x) for x in args[12:16]]  # Optional: B+ tree CSV/TGZ posts, then CSV/TGZ heights
     
     # Create subplots
     fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(14, 6))
@@ -21,7 +23,20 @@ if __name__ == "__main__":
     # Left: Posts loaded comparison
     categories = ['BST-CSV', 'Treap-CSV', 'BST-TGZ', 'Treap-TGZ']
     posts = [bst_csv_posts, treap_csv_posts, bst_tgz_posts, treap_tgz_posts]
+    heights = [bst_csv_height, treap_csv_height, bst_tgz_height, treap_tgz_height]
     colors = ['red', 'blue', 'red', 'blue']
+    if len(avl_values) == 4:
+        categories = ['BST-CSV', 'Treap-CSV', 'AVL-CSV', 'BST-TGZ', 'Treap-TGZ', 'AVL-TGZ']
+        posts = [bst_csv_posts, treap_csv_posts, avl_values[0], bst_tgz_posts, treap_tgz_posts, avl_values[1]]
+        heights = [bst_csv_height, treap_csv_height, avl_values[2], bst_tgz_height, treap_tgz_height, avl_values[3]]
+        colors = ['red', 'blue', 'purple', 'red', 'blue', 'purple']
+    if len(avl_values) == 4 and len(bplus_values) == 4:
+        categories = ['BST-CSV', 'Treap-CSV', 'AVL-CSV', 'B+-CSV', 'BST-TGZ', 'Treap-TGZ', 'AVL-TGZ', 'B+-TGZ']
+        posts = [bst_csv_posts, treap_csv_posts, avl_values[0], bplus_values[0],
+                 bst_tgz_posts, treap_tgz_posts, avl_values[1], bplus_values[1]]
+        heights = [bst_csv_height, treap_csv_height, avl_values[2], bplus_values[2],
+                   bst_tgz_height, treap_tgz_height, avl_values[3], bplus_values[3]]
+        colors = ['red', 'blue', 'purple', 'teal', 'red', 'blue', 'purple', 'teal']
     
     bars1 = ax1.bar(categories, posts, color=colors, alpha=0.7)
     ax1.set_ylabel('Posts Loaded')
@@ -36,8 +51,6 @@ if __name__ == "__main__":
                 f'{height:,}', ha='center', va='bottom', fontsize=9)
     
     # Right: Tree height comparison
-    heights = [bst_csv_height, treap_csv_height, bst_tgz_height, treap_tgz_height]
-    
     bars2 = ax2.bar(categories, heights, color=colors, alpha=0.7)
     ax2.set_ylabel('Tree Height')
     ax2.set_title('Tree Height After Loading')
@@ -11,12 +11,21 @@ if __name__ == "__main__":
     # Parse arguments
     sizes = [int(x) for x in args[:4]]  # First 4 are sizes
     bst_times = [float(x) for x in args[4:8]]  # Next 4 are BST times
-    treap_times = [float(x) for x in args[8:]]  # Last 4 are Treap times
+    treap_times = [float(x) for x in args[8:12]]  # Next 4 are Treap times
+    random_treap_times = [float(x) for x in args[12:16]]  # Optional: random-priority Treap times
+    avl_times = [float(x) for x in args[16:20]]  # Optional: AVL times
+    bplus_times = [float(x) for x in args[20:24]]  # Optional: B+ tree times
     
     # Create plot
     plt.figure(figsize=(10, 6))
     plt.plot(sizes, bst_times, 'ro-', label='BST', linewidth=2)
     plt.plot(sizes, treap_times, 'bo-', label='Treap', linewidth=2)
+    if random_treap_times:
+        plt.plot(sizes, random_treap_times, 'go-', label='Treap (random priority)', linewidth=2)
+    if avl_times:
+        plt.plot(sizes, avl_times, 'mo-', label='AVL', linewidth=2)
+    if bplus_times:
+        plt.plot(sizes, bplus_times, 'co-', label='B+ Tree', linewidth=2)
     
     plt.xlabel('Number of Posts')
     plt.ylabel('Insertion Time (ms)')
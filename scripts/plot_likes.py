@@ -12,6 +12,8 @@ if __name__ == "__main__":
     treap_multiple_likes = float(args[3])
     total_rotations = int(args[4])
     bubble_rotations = int(args[5])
+    avl_times = [float(x) for x in args[6:8]]  # Optional: AVL single and multiple like times
+    bplus_times = [float(x) for x in args[8:10]]  # Optional: B+ tree single and multiple like times
     
     # Create subplots
     fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(12, 5))
@@ -22,10 +24,14 @@ if __name__ == "__main__":
     treap_times = [treap_single_like, treap_multiple_likes]
     
     x_pos = range(len(operations))
-    width = 0.35
+    width = 0.2 if bplus_times else (0.25 if avl_times else 0.35)
     
     ax1.bar([x - width/2 for x in x_pos], bst_times, width, label='BST', color='red', alpha=0.7)
     ax1.bar([x + width/2 for x in x_pos], treap_times, width, label='Treap', color='blue', alpha=0.7)
+    if avl_times:
+        ax1.bar([x + 3*width/2 for x in x_pos], avl_times, width, label='AVL', color='purple', alpha=0.7)
+    if bplus_times:
+        ax1.bar([x + 5*width/2 for x in x_pos], bplus_times, width, label='B+ Tree', color='teal', alpha=0.7)
     ax1.set_xlabel('Like Operations')
     ax1.set_ylabel('Time (microseconds)')
     ax1.set_title('BST vs Treap - Like Performance')
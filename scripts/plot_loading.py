@@ -11,6 +11,10 @@ if __name__ == "__main__":
     treap_time = float(args[2])
     bst_height = int(args[3])
     treap_height = int(args[4])
+    avl_time = float(args[5]) if len(args) > 6 else None  # Optional: AVL time and height
+    avl_height = int(args[6]) if len(args) > 6 else None
+    bplus_time = float(args[7]) if len(args) > 8 else None  # Optional: B+ tree time and height
+    bplus_height = int(args[8]) if len(args) > 8 else None
     
     # Create subplots
     fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(12, 5))
@@ -18,8 +22,20 @@ if __name__ == "__main__":
     # Left: Loading time comparison
     structures = ['BST', 'Treap']
     times = [bst_time, treap_time]
+    heights = [bst_height, treap_height]
+    colors = ['red', 'blue']
+    if avl_time is not None:
+        structures.append('AVL')
+        times.append(avl_time)
+        heights.append(avl_height)
+        colors.append('purple')
+    if bplus_time is not None:
+        structures.append('B+')
+        times.append(bplus_time)
+        heights.append(bplus_height)
+        colors.append('teal')
     
-    bars1 = ax1.bar(structures, times, color=['red', 'blue'], alpha=0.7)
+    bars1 = ax1.bar(structures, times, color=colors, alpha=0.7)
     ax1.set_ylabel('Loading Time (seconds)')
     ax1.set_title(f'{file_type} Loading Time Comparison')
     ax1.grid(True, alpha=0.3)
@@ -31,9 +47,7 @@ if __name__ == "__main__":
                 f'{height:.1f}s', ha='center', va='bottom')
     
     # Right: Tree height comparison
-    heights = [bst_height, treap_height]
-    
-    bars2 = ax2.bar(structures, heights, color=['red', 'blue'], alpha=0.7)
+    bars2 = ax2.bar(structures, heights, color=colors, alpha=0.7)
     ax2.set_ylabel('Tree Height')
     ax2.set_title(f'Tree Height After {file_type} Loading')
     ax2.grid(True, alpha=0.3)
@@ -12,7 +12,10 @@ if __name__ == "__main__":
     treap_mixed = float(args[3])
     k_values = [int(x) for x in args[4:8]]  # k values: 5, 10, 20, 50
     bst_recent_times = [float(x) for x in args[8:12]]  # BST times for each k
-    treap_recent_times = [float(x) for x in args[12:]]  # Treap times for each k
+    treap_recent_times = [float(x) for x in args[12:16]]  # Treap times for each k
+    topk_times = [float(x) for x in args[16:18]]  # Optional: BST, Treap topKByScore times
+    avl_args = [float(x) for x in args[18:25]]  # Optional: AVL popular, mixed, 4 recent times, topK
+    bplus_args = [float(x) for x in args[25:32]]  # Optional: B+ tree, same layout as AVL
     
     # Create subplots
     fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(14, 6))
@@ -21,14 +24,27 @@ if __name__ == "__main__":
     operations_single = ['getMostPopular', 'Mixed Workload']
     bst_single_times = [bst_single_popular, bst_mixed]
     treap_single_times = [treap_single_popular, treap_mixed]
+    if len(topk_times) == 2:
+        operations_single.append('topKByScore')
+        bst_single_times.append(topk_times[0])
+        treap_single_times.append(topk_times[1])
     
     x_pos = range(len(operations_single))
-    width = 0.35
+    width = 0.2 if len(bplus_args) == 7 else (0.25 if len(avl_args) == 7 else 0.35)
     
     bars1 = ax1.bar([x - width/2 for x in x_pos], bst_single_times, width, 
                    label='BST', color='red', alpha=0.7)
     bars2 = ax1.bar([x + width/2 for x in x_pos], treap_single_times, width, 
                    label='Treap', color='blue', alpha=0.7)
+    bar_groups = [bars1, bars2]
+    if len(avl_args) == 7:
+        avl_single_times = [avl_args[0], avl_args[1], avl_args[6]][:len(operations_single)]
+        bar_groups.append(ax1.bar([x + 3*width/2 for x in x_pos], avl_single_times, width,
+                                  label='AVL', color='purple', alpha=0.7))
+    if len(bplus_args) == 7:
+        bplus_single_times = [bplus_args[0], bplus_args[1], bplus_args[6]][:len(operations_single)]
+        bar_groups.append(ax1.bar([x + 5*width/2 for x in x_pos], bplus_single_times, width,
+                                  label='B+ Tree', color='teal', alpha=0.7))
     
     ax1.set_xlabel('Query Operations')
     ax1.set_ylabel('Time (microseconds)')
@@ -39,7 +55,7 @@ if __name__ == "__main__":
     ax1.grid(True, alpha=0.3)
     
     # Add value labels on bars
-    for bars in [bars1, bars2]:
+    for bars in bar_groups:
         for bar in bars:
             height = bar.get_height()
             ax1.text(bar.get_x() + bar.get_width()/2., height,
@@ -48,6 +64,10 @@ if __name__ == "__main__":
     # Right: getMostRecent(k) performance
     ax2.plot(k_values, bst_recent_times, 'ro-', label='BST', linewidth=2, markersize=6)
     ax2.plot(k_values, treap_recent_times, 'bo-', label='Treap', linewidth=2, markersize=6)
+    if len(avl_args) == 7:
+        ax2.plot(k_values, avl_args[2:6], 'mo-', label='AVL', linewidth=2, markersize=6)
+    if len(bplus_args) == 7:
+        ax2.plot(k_values, bplus_args[2:6], 'co-', label='B+ Tree', linewidth=2, markersize=6)
     ax2.set_xlabel('Number of Recent Posts (k)')
     ax2.set_ylabel('Time per Query (microseconds)')
     ax2.set_title('getMostRecent(k) Performance')
@@ -8,15 +8,24 @@ if __name__ == "__main__":
     # Parse arguments - different structure than insertion!
     operation_names = ["getMostPopular", "getMostRecent(10)"]
     bst_times = [float(x) for x in args[:2]]      # First 2 are BST times
-    treap_times = [float(x) for x in args[2:]]    # Next 2 are Treap times
+    treap_times = [float(x) for x in args[2:4]]   # Next 2 are Treap times
+    avl_times = [float(x) for x in args[4:6]]     # Optional: AVL times
+    bplus_times = [float(x) for x in args[6:8]]   # Optional: B+ tree times
+    frozen_times = [float(x) for x in args[8:10]] # Optional: frozen snapshot times
     
     # Create bar chart
     x_pos = range(len(operation_names))
-    width = 0.35
+    width = 0.16 if frozen_times else (0.2 if bplus_times else (0.25 if avl_times else 0.35))
     
     plt.figure(figsize=(10, 6))
     plt.bar([x - width/2 for x in x_pos], bst_times, width, label='BST', color='red', alpha=0.7)
     plt.bar([x + width/2 for x in x_pos], treap_times, width, label='Treap', color='blue', alpha=0.7)
+    if avl_times:
+        plt.bar([x + 3*width/2 for x in x_pos], avl_times, width, label='AVL', color='purple', alpha=0.7)
+    if bplus_times:
+        plt.bar([x + 5*width/2 for x in x_pos], bplus_times, width, label='B+ Tree', color='teal', alpha=0.7)
+    if frozen_times:
+        plt.bar([x + 7*width/2 for x in x_pos], frozen_times, width, label='Frozen snapshot', color='orange', alpha=0.7)
     
     plt.xlabel('Search Operations')
     plt.ylabel('Time (microseconds)')